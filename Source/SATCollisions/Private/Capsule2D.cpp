@@ -0,0 +1,172 @@
+#include "Capsule2D.h"
+
+#include "DrawDebugHelpers.h"
+#include "SATCollisionSubsystem.h"
+
+ACapsule2D::ACapsule2D()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	RootComponent = Root;
+}
+
+void ACapsule2D::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Root->TransformUpdated.AddUObject(this, &ACapsule2D::OnRootTransformUpdated);
+	UpdateWorldCapsule();
+
+	if (auto* SAT = GetWorld()->GetSubsystem<USATCollisionSubsystem>())
+	{
+		SAT->RegisterCapsule(this);
+	}
+
+	OnSATOverlapBeginDelegate.AddDynamic(this, &ACapsule2D::HandleSATOverlapBegin);
+	OnSATOverlapEndDelegate.AddDynamic(this, &ACapsule2D::HandleSATOverlapEnd);
+}
+
+void ACapsule2D::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	UpdateWorldCapsule();
+}
+
+#if WITH_EDITOR
+void ACapsule2D::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	UpdateWorldCapsule();
+}
+#endif
+
+void ACapsule2D::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	Root->TransformUpdated.RemoveAll(this);
+
+	if (auto* SAT = GetWorld()->GetSubsystem<USATCollisionSubsystem>())
+	{
+		SAT->UnregisterCapsule(this);
+	}
+}
+
+void ACapsule2D::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DrawDebugCapsule2D();
+}
+
+void ACapsule2D::SetCapsule(float InHalfLength, float InRadius)
+{
+	HalfLength = InHalfLength;
+	Radius = InRadius;
+	UpdateWorldCapsule();
+}
+
+void ACapsule2D::SetHalfLength(float InHalfLength)
+{
+	HalfLength = InHalfLength;
+	UpdateWorldCapsule();
+}
+
+void ACapsule2D::SetRadius(float InRadius)
+{
+	Radius = InRadius;
+	UpdateWorldCapsule();
+}
+
+void ACapsule2D::UpdateWorldCapsule() const
+{
+	ComputeWorldCapsule(GetActorTransform(), HalfLength, Radius, WorldStart, WorldEnd, WorldRadius);
+
+	BuiltHalfLength = HalfLength;
+	BuiltRadius = Radius;
+}
+
+void ACapsule2D::ComputeWorldCapsule(const FTransform& Transform, float InHalfLength, float InRadius,
+                                     FVector2D& OutStart, FVector2D& OutEnd, float& OutRadius)
+{
+	const FVector Start = Transform.TransformPosition(FVector(-InHalfLength, 0.f, 0.f));
+	const FVector End = Transform.TransformPosition(FVector(InHalfLength, 0.f, 0.f));
+	OutStart = FVector2D(Start.X, Start.Y);
+	OutEnd = FVector2D(End.X, End.Y);
+
+	const FVector Scale = Transform.GetScale3D().GetAbs();
+	OutRadius = InRadius * FMath::Max(Scale.X, Scale.Y);
+}
+
+void ACapsule2D::RefreshWorldCapsule() const
+{
+	if (HalfLength != BuiltHalfLength || Radius != BuiltRadius)
+	{
+		UpdateWorldCapsule();
+	}
+}
+
+void ACapsule2D::OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+                                        ETeleportType Teleport)
+{
+	UpdateWorldCapsule();
+}
+
+void ACapsule2D::HandleSATOverlapBegin(AActor* OtherActor)
+{
+	OnSATOverlapBegin(OtherActor);  // Calls virtual function
+	UE_LOG(LogTemp, Warning, TEXT("%s began overlapping with %s"), *GetName(), *OtherActor->GetName());
+}
+
+void ACapsule2D::HandleSATOverlapEnd(AActor* OtherActor)
+{
+	OnSATOverlapEnd(OtherActor);  // Calls virtual function
+	UE_LOG(LogTemp, Warning, TEXT("%s ended overlapping with %s"), *GetName(), *OtherActor->GetName());
+}
+
+void ACapsule2D::OnSATOverlapBegin_Implementation(AActor* OtherActor)
+{
+}
+
+void ACapsule2D::OnSATOverlapEnd_Implementation(AActor* OtherActor)
+{
+}
+
+void ACapsule2D::DrawDebugCapsule2D() const
+{
+	RefreshWorldCapsule();
+	if (Segments < 2 || WorldRadius <= 0 || !GetWorld()) return;
+
+	const float Z = GetActorLocation().Z + ZOffset;
+	const FVector2D Axis = (WorldEnd - WorldStart).GetSafeNormal();
+	const FVector2D Direction = Axis.IsNearlyZero() ? FVector2D(1.f, 0.f) : Axis;
+	const FVector2D Side(-Direction.Y, Direction.X);
+
+	// Straight sides
+	DrawDebugLine(GetWorld(), FVector(WorldStart + Side * WorldRadius, Z), FVector(WorldEnd + Side * WorldRadius, Z), ShapeColor, false, 1.f, 0, 1.f);
+	DrawDebugLine(GetWorld(), FVector(WorldStart - Side * WorldRadius, Z), FVector(WorldEnd - Side * WorldRadius, Z), ShapeColor, false, 1.f, 0, 1.f);
+
+	// Half circle around each end, sweeping from one side to the other through the outward direction
+	auto DrawCap = [&](const FVector2D& Center, const FVector2D& Outward)
+	{
+		const FVector2D From = FVector2D(-Outward.Y, Outward.X);
+		const float AngleStep = PI / Segments;
+
+		FVector LastPoint(Center + From * WorldRadius, Z);
+		for (int32 i = 1; i <= Segments; ++i)
+		{
+			const float Angle = i * AngleStep;
+			const FVector2D Offset = (From * FMath::Cos(Angle) + Outward * FMath::Sin(Angle)) * WorldRadius;
+
+			const FVector ThisPoint(Center + Offset, Z);
+			DrawDebugLine(GetWorld(), LastPoint, ThisPoint, ShapeColor, false, 1.f, 0, 1.f);
+			LastPoint = ThisPoint;
+		}
+	};
+
+	DrawCap(WorldEnd, Direction);
+	DrawCap(WorldStart, -Direction);
+}
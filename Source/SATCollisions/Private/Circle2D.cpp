@@ -15,6 +15,9 @@ void ACircle2D::BeginPlay()
 {
 	Super::BeginPlay();
 
+	Root->TransformUpdated.AddUObject(this, &ACircle2D::OnRootTransformUpdated);
+	UpdateWorldCircle();
+
 	if (auto* SAT = GetWorld()->GetSubsystem<USATCollisionSubsystem>())
 	{
 		SAT->RegisterCircle(this);
@@ -24,10 +27,28 @@ void ACircle2D::BeginPlay()
 	OnSATOverlapEndDelegate.AddDynamic(this, &ACircle2D::HandleSATOverlapEnd);
 }
 
+void ACircle2D::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	UpdateWorldCircle();
+}
+
+#if WITH_EDITOR
+void ACircle2D::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	UpdateWorldCircle();
+}
+#endif
+
 void ACircle2D::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	Root->TransformUpdated.RemoveAll(this);
+
 	if (auto* SAT = GetWorld()->GetSubsystem<USATCollisionSubsystem>())
 	{
 		SAT->UnregisterCircle(this);
@@ -47,6 +68,58 @@ void ACircle2D::SetCircle(float InX, float InY, float InRadius)
 	X = InX;
 	Y = InY;
 	Radius = InRadius;
+	UpdateWorldCircle();
+}
+
+void ACircle2D::SetX(float InX)
+{
+	X = InX;
+	UpdateWorldCircle();
+}
+
+void ACircle2D::SetY(float InY)
+{
+	Y = InY;
+	UpdateWorldCircle();
+}
+
+void ACircle2D::SetRadius(float InRadius)
+{
+	Radius = InRadius;
+	UpdateWorldCircle();
+}
+
+void ACircle2D::UpdateWorldCircle() const
+{
+	ComputeWorldCircle(GetActorTransform(), X, Y, Radius, WorldCenter, WorldRadius);
+
+	BuiltX = X;
+	BuiltY = Y;
+	BuiltRadius = Radius;
+}
+
+void ACircle2D::ComputeWorldCircle(const FTransform& Transform, float InX, float InY, float InRadius,
+                                   FVector2D& OutCenter, float& OutRadius)
+{
+	const FVector World = Transform.TransformPosition(FVector(InX, InY, 0.f));
+	OutCenter = FVector2D(World.X, World.Y);
+
+	const FVector Scale = Transform.GetScale3D().GetAbs();
+	OutRadius = InRadius * FMath::Max(Scale.X, Scale.Y);
+}
+
+void ACircle2D::RefreshWorldCircle() const
+{
+	if (X != BuiltX || Y != BuiltY || Radius != BuiltRadius)
+	{
+		UpdateWorldCircle();
+	}
+}
+
+void ACircle2D::OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+                                       ETeleportType Teleport)
+{
+	UpdateWorldCircle();
 }
 
 void ACircle2D::HandleSATOverlapBegin(AActor* OtherActor)
@@ -71,18 +144,19 @@ void ACircle2D::OnSATOverlapEnd_Implementation(AActor* OtherActor)
 
 void ACircle2D::DrawDebugCircle2D() const
 {
-	if (Segments<3 || Radius <= 0 || !GetWorld()) return;
+	RefreshWorldCircle();
+	if (Segments<3 || WorldRadius <= 0 || !GetWorld()) return;
 	
-	FVector Center = GetActorLocation() + FVector(0, 0, ZOffset);
+	FVector Center = FVector(WorldCenter, GetActorLocation().Z + ZOffset);
     
 	float AngleStep = 2 * PI / Segments;
-	FVector LastPoint = Center + FVector(Radius, 0, 0);
+	FVector LastPoint = Center + FVector(WorldRadius, 0, 0);
 
 	for (int32 i = 1; i <= Segments; ++i)
 	{
 		float Angle = i * AngleStep;
 
-		FVector ThisPoint = Center + FVector(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, 0);
+		FVector ThisPoint = Center + FVector(FMath::Cos(Angle) * WorldRadius, FMath::Sin(Angle) * WorldRadius, 0);
         
 		DrawDebugLine(GetWorld(), LastPoint, ThisPoint, ShapeColor, false, 1.0f, 0, 1.0f);
 		LastPoint = ThisPoint;
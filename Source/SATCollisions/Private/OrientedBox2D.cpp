@@ -0,0 +1,143 @@
+#include "OrientedBox2D.h"
+
+#include "DrawDebugHelpers.h"
+#include "SATCollisionSubsystem.h"
+
+AOrientedBox2D::AOrientedBox2D()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+	RootComponent = Root;
+}
+
+void AOrientedBox2D::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Root->TransformUpdated.AddUObject(this, &AOrientedBox2D::OnRootTransformUpdated);
+	UpdateWorldBox();
+
+	if (auto* SAT = GetWorld()->GetSubsystem<USATCollisionSubsystem>())
+	{
+		SAT->RegisterBox(this);
+	}
+
+	OnSATOverlapBeginDelegate.AddDynamic(this, &AOrientedBox2D::HandleSATOverlapBegin);
+	OnSATOverlapEndDelegate.AddDynamic(this, &AOrientedBox2D::HandleSATOverlapEnd);
+}
+
+void AOrientedBox2D::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	UpdateWorldBox();
+}
+
+#if WITH_EDITOR
+void AOrientedBox2D::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	UpdateWorldBox();
+}
+#endif
+
+void AOrientedBox2D::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	Root->TransformUpdated.RemoveAll(this);
+
+	if (auto* SAT = GetWorld()->GetSubsystem<USATCollisionSubsystem>())
+	{
+		SAT->UnregisterBox(this);
+	}
+}
+
+void AOrientedBox2D::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	DrawDebugOrientedBox2D();
+}
+
+void AOrientedBox2D::SetHalfExtents(FVector2D InHalfExtents)
+{
+	HalfExtents = InHalfExtents;
+	UpdateWorldBox();
+}
+
+void AOrientedBox2D::UpdateWorldBox() const
+{
+	ComputeWorldBox(GetActorTransform(), HalfExtents, WorldCenter, WorldHalfExtents, WorldAxisX);
+
+	BuiltHalfExtents = HalfExtents;
+}
+
+void AOrientedBox2D::ComputeWorldBox(const FTransform& Transform, const FVector2D& InHalfExtents,
+                                     FVector2D& OutCenter, FVector2D& OutHalfExtents, FVector2D& OutAxisX)
+{
+	const FVector Center = Transform.GetLocation();
+	OutCenter = FVector2D(Center.X, Center.Y);
+
+	const FVector AxisX = Transform.GetUnitAxis(EAxis::X);
+	OutAxisX = FVector2D(AxisX.X, AxisX.Y).GetSafeNormal();
+	if (OutAxisX.IsNearlyZero())
+	{
+		OutAxisX = FVector2D(1.f, 0.f);
+	}
+
+	const FVector Scale = Transform.GetScale3D().GetAbs();
+	OutHalfExtents = FVector2D(InHalfExtents.X * Scale.X, InHalfExtents.Y * Scale.Y).GetAbs();
+}
+
+void AOrientedBox2D::RefreshWorldBox() const
+{
+	if (HalfExtents != BuiltHalfExtents)
+	{
+		UpdateWorldBox();
+	}
+}
+
+void AOrientedBox2D::OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+                                        ETeleportType Teleport)
+{
+	UpdateWorldBox();
+}
+
+void AOrientedBox2D::HandleSATOverlapBegin(AActor* OtherActor)
+{
+	OnSATOverlapBegin(OtherActor);  // Calls virtual function
+	UE_LOG(LogTemp, Warning, TEXT("%s began overlapping with %s"), *GetName(), *OtherActor->GetName());
+}
+
+void AOrientedBox2D::HandleSATOverlapEnd(AActor* OtherActor)
+{
+	OnSATOverlapEnd(OtherActor);  // Calls virtual function
+	UE_LOG(LogTemp, Warning, TEXT("%s ended overlapping with %s"), *GetName(), *OtherActor->GetName());
+}
+
+void AOrientedBox2D::OnSATOverlapBegin_Implementation(AActor* OtherActor)
+{
+}
+
+void AOrientedBox2D::OnSATOverlapEnd_Implementation(AActor* OtherActor)
+{
+}
+
+void AOrientedBox2D::DrawDebugOrientedBox2D() const
+{
+	RefreshWorldBox();
+	if (!GetWorld()) return;
+
+	const float Z = GetActorLocation().Z + ZOffset;
+	const FVector2D X = WorldAxisX * WorldHalfExtents.X;
+	const FVector2D Y = FVector2D(-WorldAxisX.Y, WorldAxisX.X) * WorldHalfExtents.Y;
+	const FVector2D Corners[4] = { WorldCenter - X - Y, WorldCenter + X - Y, WorldCenter + X + Y, WorldCenter - X + Y };
+
+	for (int32 i = 0; i < 4; ++i)
+	{
+		DrawDebugLine(GetWorld(), FVector(Corners[i], Z), FVector(Corners[(i + 1) % 4], Z), ShapeColor, false, 1.f, 0, 1.f);
+	}
+}
@@ -3,6 +3,7 @@
 #include "Circle2D.h"
 #include "DrawDebugHelpers.h"
 #include "SATCollisionSubsystem.h"
+#include "SATHullAsset.h"
 
 APolygon2D::APolygon2D()
 {
@@ -55,6 +56,23 @@ void APolygon2D::ClearPolygon()
 	Points.Empty();
 }
 
+TArray<FVector2D> APolygon2D::GetLocalPoints() const
+{
+	const FSATHull* SharedHull = Hull ? Hull->GetHull().Get() : nullptr;
+	if (!SharedHull)
+	{
+		return Points;
+	}
+
+	TArray<FVector2D> HullPoints;
+	HullPoints.Reserve(SharedHull->Points.Num());
+	for (const FVector2f& Point : SharedHull->Points)
+	{
+		HullPoints.Add(FVector2D(Point));
+	}
+	return HullPoints;
+}
+
 TArray<FVector2D> APolygon2D::GetTransformedPoints(const FTransform& Transform) const
 {
 	TArray<FVector2D> Result;
@@ -89,7 +107,8 @@ void APolygon2D::TranslatePoints(const FVector2D& Offset)
 
 FVector2D APolygon2D::GetCentroidWorld() const
 {
-	if (Points.Num() == 0)
+	const TArray<FVector2D> LocalPoints = GetLocalPoints();
+	if (LocalPoints.Num() == 0)
 	{
 		return FVector2D::ZeroVector;
 	}
@@ -98,14 +117,14 @@ FVector2D APolygon2D::GetCentroidWorld() const
 
 	const FTransform& WorldTransform = GetActorTransform();
 
-	for (const FVector2D& Point : Points)
+	for (const FVector2D& Point : LocalPoints)
 	{
 		FVector WorldPoint3D = WorldTransform.TransformPosition(FVector(Point, 0.0f));
 		Sum.X += WorldPoint3D.X;
 		Sum.Y += WorldPoint3D.Y;
 	}
 
-	return Sum / Points.Num();
+	return Sum / LocalPoints.Num();
 }
 
 void APolygon2D::HandleSATOverlapBegin(AActor* OtherActor)
@@ -130,12 +149,13 @@ void APolygon2D::OnSATOverlapEnd_Implementation(AActor* OtherActor)
 
 void APolygon2D::DrawDebugPolygon() const
 {
-	if (Points.Num() < 2) return;
+	const TArray<FVector2D> LocalPoints = GetLocalPoints();
+	if (LocalPoints.Num() < 2) return;
 
-	for (int i = 0; i < Points.Num(); ++i)
+	for (int i = 0; i < LocalPoints.Num(); ++i)
 	{
-		const FVector2D& Current = Points[i];
-		const FVector2D& Next = Points[(i + 1) % Points.Num()];
+		const FVector2D& Current = LocalPoints[i];
+		const FVector2D& Next = LocalPoints[(i + 1) % LocalPoints.Num()];
 
 		FVector Start = GetActorTransform().TransformPosition(FVector(Current.X, Current.Y, 0.f));
 		FVector End   = GetActorTransform().TransformPosition(FVector(Next.X, Next.Y, 0.f));
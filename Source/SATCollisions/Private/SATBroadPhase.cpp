@@ -0,0 +1,92 @@
+#include "SATBroadPhase.h"
+
+void FSATBroadPhase::UpdatePairs(const FSATFrameState& Frame, const TArray<int32>& Shapes,
+                                 TArray<TPair<int32, int32>>& OutPairs)
+{
+	++UpdateCount;
+
+	for (int32 ShapeIndex : Shapes)
+	{
+		const FSATShapeState& Shape = Frame.Shapes[ShapeIndex];
+
+		FProxy* Proxy = Proxies.Find(Shape.Id);
+		if (!Proxy)
+		{
+			Proxy = &Proxies.Add(Shape.Id);
+			Proxy->ProxyId = Tree.CreateProxy(Shape.WorldBounds, Shape.Id);
+		}
+		else
+		{
+			Tree.MoveProxy(Proxy->ProxyId, Shape.WorldBounds);
+		}
+		Proxy->LastUpdate = UpdateCount;
+
+		if (ShapeIndexByProxy.Num() < Tree.GetProxyCapacity())
+		{
+			ShapeIndexByProxy.SetNum(Tree.GetProxyCapacity());
+		}
+		ShapeIndexByProxy[Proxy->ProxyId] = ShapeIndex;
+	}
+
+	for (auto It = Proxies.CreateIterator(); It; ++It)
+	{
+		if (It.Value().LastUpdate != UpdateCount)
+		{
+			Tree.DestroyProxy(It.Value().ProxyId);
+			It.RemoveCurrent();
+		}
+	}
+
+	Tree.QueryAllPairs([this, &OutPairs](int32 ProxyA, int32 ProxyB)
+	{
+		const int32 ShapeA = ShapeIndexByProxy[ProxyA];
+		const int32 ShapeB = ShapeIndexByProxy[ProxyB];
+		OutPairs.Emplace(FMath::Min(ShapeA, ShapeB), FMath::Max(ShapeA, ShapeB));
+	});
+
+	// Traversal order depends on the tree's insertion history; sorting keeps the narrow phase, and
+	// so the order Block pairs get resolved in, the same for a live frame and its replay
+	OutPairs.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+	{
+		return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+	});
+}
+
+void FSATBroadPhase::Query(const FBox2D& Bounds, TArray<uint32>& OutIds) const
+{
+	Tree.Query(Bounds, [this, &OutIds](int32 ProxyId)
+	{
+		OutIds.Add(Tree.GetUserData(ProxyId));
+	});
+}
+
+void FSATBroadPhase::AddLastContacts(FSATFrameState& Frame) const
+{
+	for (const TPair<TPair<uint32, uint32>, FLastContact>& Entry : LastContacts)
+	{
+		// UpdatePairs dropped the proxies of shapes that are gone or no longer collidable
+		const FProxy* ProxyA = Proxies.Find(Entry.Value.IdA);
+		const FProxy* ProxyB = Proxies.Find(Entry.Value.IdB);
+		if (!ProxyA || !ProxyB) continue;
+
+		const int32 ShapeA = ShapeIndexByProxy[ProxyA->ProxyId];
+		const int32 ShapeB = ShapeIndexByProxy[ProxyB->ProxyId];
+		if (!Frame.Shapes[ShapeA].bDormant || !Frame.Shapes[ShapeB].bDormant) continue;
+
+		FSATContact& Contact = Frame.Contacts.Add_GetRef(Entry.Value.Contact);
+		Contact.ShapeA = ShapeA;
+		Contact.ShapeB = ShapeB;
+	}
+}
+
+void FSATBroadPhase::StoreContacts(const FSATFrameState& Frame)
+{
+	LastContacts.Reset();
+
+	for (const FSATContact& Contact : Frame.Contacts)
+	{
+		const uint32 IdA = Frame.Shapes[Contact.ShapeA].Id;
+		const uint32 IdB = Frame.Shapes[Contact.ShapeB].Id;
+		LastContacts.Add(IdA < IdB ? MakeTuple(IdA, IdB) : MakeTuple(IdB, IdA), { IdA, IdB, Contact });
+	}
+}
@@ -0,0 +1,357 @@
+#include "SATCollisionSnapshot.h"
+
+#include "HAL/FileManager.h"
+
+namespace
+{
+	constexpr uint32 SATRecordingMagic = 0x53415452; // 'SATR'
+	constexpr uint32 SATRecordingVersion = 5;
+}
+
+void FSATShapeState::UpdateWorldData()
+{
+	AppliedOffset = FVector2D::ZeroVector;
+
+	// Everything below is computed in double, then stored relative to Origin
+	auto ToLocal = [this](const FVector2D& World) { return FSATVector2(World - Origin); };
+
+	if (Type == ESATShapeType::Polygon)
+	{
+		// The origin is taken from the outline's bounds rather than the actor, which may be far
+		// from it, so a large hull's points are all as close to it as they can be
+		TArray<FVector2D, TInlineAllocator<16>> World;
+		WorldBounds = FBox2D(ForceInit);
+
+		auto AddWorldPoint = [&](double X, double Y)
+		{
+			World.Add(FVector2D(Transform.TransformPosition(FVector(X, Y, 0.0))));
+			WorldBounds += World.Last();
+		};
+
+		auto ConvertWorldPoints = [&]()
+		{
+			const FVector Location = Transform.GetLocation();
+			Origin = GetSATRegionOrigin(World.Num() > 0 ? WorldBounds.GetCenter() : FVector2D(Location.X, Location.Y));
+			WorldCenter = ToLocal(FVector2D(Location.X, Location.Y));
+
+			WorldPoints.Reset(World.Num());
+			for (const FVector2D& Point : World)
+			{
+				WorldPoints.Add(ToLocal(Point));
+			}
+		};
+
+		if (Hull.IsValid())
+		{
+			for (const FVector2f& LocalPoint : Hull->Points)
+			{
+				AddWorldPoint(LocalPoint.X, LocalPoint.Y);
+			}
+			ConvertWorldPoints();
+
+			// The hull's normals are already outward. Scaling them by the inverse scale keeps them
+			// perpendicular under non-uniform scale and flips them along with a mirrored outline.
+			const FVector InverseScale = FTransform::GetSafeScaleReciprocal(Transform.GetScale3D());
+			const FQuat Rotation = Transform.GetRotation();
+
+			WorldNormals.Reset(Hull->Normals.Num());
+			for (const FVector2f& LocalNormal : Hull->Normals)
+			{
+				const FVector Normal = Rotation.RotateVector(FVector(LocalNormal.X * InverseScale.X, LocalNormal.Y * InverseScale.Y, 0.0));
+				WorldNormals.Add(FSATVector2(Normal.X, Normal.Y).GetSafeNormal());
+			}
+		}
+		else
+		{
+			for (const FVector2D& LocalPoint : Points)
+			{
+				AddWorldPoint(LocalPoint.X, LocalPoint.Y);
+			}
+			ConvertWorldPoints();
+
+			FSATReal SignedArea = 0;
+			for (int32 i = 0; i < WorldPoints.Num(); ++i)
+			{
+				SignedArea += FSATVector2::CrossProduct(WorldPoints[i], WorldPoints[(i + 1) % WorldPoints.Num()]);
+			}
+			const FSATReal Winding = SignedArea < 0 ? -1 : 1;
+
+			WorldNormals.Reset(WorldPoints.Num());
+			for (int32 i = 0; i < WorldPoints.Num(); ++i)
+			{
+				const FSATVector2 Edge = WorldPoints[(i + 1) % WorldPoints.Num()] - WorldPoints[i];
+				WorldNormals.Add(FSATVector2(Edge.Y, -Edge.X).GetSafeNormal() * Winding);
+			}
+		}
+	}
+	else if (Type == ESATShapeType::Circle)
+	{
+		Origin = GetSATRegionOrigin(Center);
+		WorldCenter = ToLocal(Center);
+		WorldBounds = FBox2D(Center - FVector2D(Radius), Center + FVector2D(Radius));
+	}
+	else if (Type == ESATShapeType::Capsule)
+	{
+		const FVector2D Middle = Points.Num() == 2 ? (Points[0] + Points[1]) * 0.5 : FVector2D::ZeroVector;
+		Origin = GetSATRegionOrigin(Middle);
+		WorldCenter = ToLocal(Middle);
+
+		WorldPoints.Reset(Points.Num());
+		for (const FVector2D& Point : Points)
+		{
+			WorldPoints.Add(ToLocal(Point));
+		}
+		WorldNormals.Reset();
+		WorldBounds = Points.Num() > 0 ? FBox2D(Points).ExpandBy(Radius) : FBox2D(ForceInit);
+	}
+	else
+	{
+		Origin = GetSATRegionOrigin(Center);
+		WorldCenter = ToLocal(Center);
+		WorldAxes[0] = FSATVector2(AxisX);
+		WorldAxes[1] = FSATVector2(-AxisX.Y, AxisX.X);
+		WorldHalfExtents = FSATVector2(HalfExtents);
+
+		// Corners counter-clockwise, with normal i belonging to the edge from corner i to i + 1
+		const FSATVector2 X = WorldAxes[0] * WorldHalfExtents.X;
+		const FSATVector2 Y = WorldAxes[1] * WorldHalfExtents.Y;
+		WorldPoints = { WorldCenter - X - Y, WorldCenter + X - Y, WorldCenter + X + Y, WorldCenter - X + Y };
+		WorldNormals = { -WorldAxes[1], WorldAxes[0], WorldAxes[1], -WorldAxes[0] };
+
+		const FVector2D Extent(FMath::Abs(X.X) + FMath::Abs(Y.X), FMath::Abs(X.Y) + FMath::Abs(Y.Y));
+		WorldBounds = FBox2D(Center - Extent, Center + Extent);
+	}
+}
+
+void FSATShapeState::Translate(const FSATVector2& Delta)
+{
+	// Transform is left untouched so the recorded state stays the tick's input
+	AppliedOffset += FVector2D(Delta);
+	WorldBounds = WorldBounds.ShiftBy(FVector2D(Delta));
+	WorldCenter += Delta;
+	for (FSATVector2& Point : WorldPoints)
+	{
+		Point += Delta;
+	}
+}
+
+void FSATShapeState::Rebase(const FVector2D& NewOrigin)
+{
+	// Region origins are multiples of SATRegionSize, so the shift itself is exact, but adding it to
+	// the points rounds them (e.g. 4000.3f + 8192 does not fit a float's mantissa exactly)
+	const FSATVector2 Shift(Origin - NewOrigin);
+	Origin = NewOrigin;
+	WorldCenter += Shift;
+	for (FSATVector2& Point : WorldPoints)
+	{
+		Point += Shift;
+	}
+}
+
+bool FSATShapeState::HasArea() const
+{
+	switch (Type)
+	{
+	case ESATShapeType::Polygon:
+		return (Hull.IsValid() ? Hull->Points.Num() : Points.Num()) >= 3;
+	case ESATShapeType::Circle:
+		return Radius > 0.f;
+	case ESATShapeType::Capsule:
+		return Points.Num() == 2 && Radius > 0.f;
+	case ESATShapeType::Box:
+		return HalfExtents.X > 0.f && HalfExtents.Y > 0.f;
+	}
+	return false;
+}
+
+FArchive& operator<<(FArchive& Ar, FSATShapeState& Shape)
+{
+	uint8 Type = static_cast<uint8>(Shape.Type);
+	uint8 Response = static_cast<uint8>(Shape.Response);
+
+	Ar << Shape.Id;
+	Ar << Type;
+	Ar << Response;
+	Ar << Shape.bDormant;
+	Ar << Shape.Transform;
+
+	switch (static_cast<ESATShapeType>(Type))
+	{
+	case ESATShapeType::Polygon:
+		if (Ar.IsSaving() && Shape.Hull.IsValid())
+		{
+			// Recordings stay self-contained, replay reads the hull back as plain points
+			TArray<FVector2D> HullPoints;
+			HullPoints.Reserve(Shape.Hull->Points.Num());
+			for (const FVector2f& Point : Shape.Hull->Points)
+			{
+				HullPoints.Add(FVector2D(Point));
+			}
+			Ar << HullPoints;
+		}
+		else
+		{
+			Ar << Shape.Points;
+		}
+		break;
+	case ESATShapeType::Circle:
+		Ar << Shape.Center;
+		Ar << Shape.Radius;
+		break;
+	case ESATShapeType::Capsule:
+		Ar << Shape.Points;
+		Ar << Shape.Radius;
+		break;
+	case ESATShapeType::Box:
+		Ar << Shape.Center;
+		Ar << Shape.HalfExtents;
+		Ar << Shape.AxisX;
+		break;
+	}
+
+	Shape.Type = static_cast<ESATShapeType>(Type);
+	Shape.Response = static_cast<ESATCollisionResponse>(Response);
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FSATContact& Contact)
+{
+	Ar << Contact.ShapeA;
+	Ar << Contact.ShapeB;
+	Ar << Contact.Axis;
+	Ar << Contact.Overlap;
+	Ar << Contact.NumPoints;
+	Contact.NumPoints = FMath::Clamp(Contact.NumPoints, 0, 2);
+	for (int32 i = 0; i < Contact.NumPoints; ++i)
+	{
+		Ar << Contact.Points[i].Position;
+		Ar << Contact.Points[i].Depth;
+	}
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FSATEventRecord& Event)
+{
+	Ar << Event.IdA;
+	Ar << Event.IdB;
+	Ar << Event.bBegin;
+	return Ar;
+}
+
+void FSATFrameState::ResetResults()
+{
+	Contacts.Reset();
+	Events.Reset();
+}
+
+void FSATFrameState::BuildEvents(TSet<TPair<uint32, uint32>>& InOutOverlapIds)
+{
+	TSet<TPair<uint32, uint32>> CurrentOverlapIds;
+	CurrentOverlapIds.Reserve(Contacts.Num());
+
+	for (const FSATContact& Contact : Contacts)
+	{
+		const uint32 IdA = Shapes[Contact.ShapeA].Id;
+		const uint32 IdB = Shapes[Contact.ShapeB].Id;
+		const TPair<uint32, uint32> Pair = IdA < IdB ? MakeTuple(IdA, IdB) : MakeTuple(IdB, IdA);
+
+		bool bAlreadyInSet = false;
+		CurrentOverlapIds.Add(Pair, &bAlreadyInSet);
+		if (!bAlreadyInSet && !InOutOverlapIds.Contains(Pair))
+		{
+			Events.Add({ Pair.Key, Pair.Value, true });
+		}
+	}
+
+	for (const TPair<uint32, uint32>& Pair : InOutOverlapIds)
+	{
+		if (!CurrentOverlapIds.Contains(Pair))
+		{
+			Events.Add({ Pair.Key, Pair.Value, false });
+		}
+	}
+
+	InOutOverlapIds = MoveTemp(CurrentOverlapIds);
+}
+
+FArchive& operator<<(FArchive& Ar, FSATFrameState& Frame)
+{
+	Ar << Frame.FrameNumber;
+	Ar << Frame.DeltaTime;
+	Ar << Frame.bGenerateContactPoints;
+	Ar << Frame.Shapes;
+	Ar << Frame.Contacts;
+	Ar << Frame.Events;
+	return Ar;
+}
+
+bool FSATCollisionRecorder::Open(const FString& InFilename)
+{
+	Close();
+
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*InFilename));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("SAT recorder could not open %s for writing"), *InFilename);
+		return false;
+	}
+
+	uint32 Magic = SATRecordingMagic;
+	uint32 Version = SATRecordingVersion;
+	*Writer << Magic;
+	*Writer << Version;
+
+	Filename = InFilename;
+	NumFrames = 0;
+	UE_LOG(LogTemp, Log, TEXT("SAT recording started: %s"), *Filename);
+	return true;
+}
+
+void FSATCollisionRecorder::Close()
+{
+	if (!Writer.IsValid()) return;
+
+	Writer->Close();
+	Writer.Reset();
+	UE_LOG(LogTemp, Log, TEXT("SAT recording stopped: %s (%d frames)"), *Filename, NumFrames);
+}
+
+void FSATCollisionRecorder::WriteFrame(FSATFrameState& Frame)
+{
+	if (!Writer.IsValid()) return;
+
+	*Writer << Frame;
+	++NumFrames;
+}
+
+bool FSATCollisionReplayReader::Open(const FString& Filename)
+{
+	Reader.Reset(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Reader.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("SAT replay could not open %s"), *Filename);
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	*Reader << Magic;
+	*Reader << Version;
+
+	if (Magic != SATRecordingMagic || Version != SATRecordingVersion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not a SAT recording this build can read (version %u)"), *Filename, Version);
+		Reader.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FSATCollisionReplayReader::ReadFrame(FSATFrameState& OutFrame)
+{
+	if (!Reader.IsValid() || Reader->AtEnd()) return false;
+
+	*Reader << OutFrame;
+	return !Reader->IsError();
+}
@@ -3,181 +3,1190 @@
 #include <vector>
 
 #include "Polygon2D.h"
+#include "SATHullAsset.h"
 #include "Circle2D.h"
+#include "Capsule2D.h"
+#include "OrientedBox2D.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Algo/AnyOf.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Count.h"
+
+DECLARE_CYCLE_STAT(TEXT("Detect Collisions"), STAT_SATDetectCollisions, STATGROUP_SATCollision);
+DECLARE_CYCLE_STAT(TEXT("Broad Phase"), STAT_SATBroadPhase, STATGROUP_SATCollision);
+DECLARE_CYCLE_STAT(TEXT("Async Sync Stall"), STAT_SATSyncStall, STATGROUP_SATCollision);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Async Result Latency (ms)"), STAT_SATResultLatency, STATGROUP_SATCollision);
+
+namespace
+{
+	// The shape actors share their event/debug interface without sharing a base class
+	template <typename FuncType>
+	void VisitShapeActor(AActor* Actor, FuncType&& Func)
+	{
+		if (APolygon2D* Polygon = Cast<APolygon2D>(Actor))
+		{
+			Func(*Polygon);
+		}
+		else if (ACircle2D* Circle = Cast<ACircle2D>(Actor))
+		{
+			Func(*Circle);
+		}
+		else if (ACapsule2D* Capsule = Cast<ACapsule2D>(Actor))
+		{
+			Func(*Capsule);
+		}
+		else if (AOrientedBox2D* Box = Cast<AOrientedBox2D>(Actor))
+		{
+			Func(*Box);
+		}
+	}
+
+	// Row-major index into USATCollisionSubsystem::CollidePairsTable
+	int32 PairBucket(const FSATFrameState& Frame, const TPair<int32, int32>& Pair)
+	{
+		return static_cast<int32>(Frame.Shapes[Pair.Key].Type) * SATNumShapeTypes + static_cast<int32>(Frame.Shapes[Pair.Value].Type);
+	}
+
+	// Closest points between segments P1-Q1 and P2-Q2 (Ericson, Real-Time Collision Detection 5.1.9)
+	void ClosestPointsBetweenSegments(const FSATVector2& P1, const FSATVector2& Q1, const FSATVector2& P2, const FSATVector2& Q2,
+	                                  FSATVector2& OutC1, FSATVector2& OutC2)
+	{
+		const FSATVector2 D1 = Q1 - P1;
+		const FSATVector2 D2 = Q2 - P2;
+		const FSATVector2 R = P1 - P2;
+		const FSATReal A = D1.SizeSquared();
+		const FSATReal E = D2.SizeSquared();
+		const FSATReal F = FSATVector2::DotProduct(D2, R);
+
+		FSATReal S = 0.f;
+		FSATReal T = 0.f;
+
+		if (A <= SMALL_NUMBER && E <= SMALL_NUMBER)
+		{
+			// Both segments are points
+		}
+		else if (A <= SMALL_NUMBER)
+		{
+			T = FMath::Clamp(F / E, FSATReal(0), FSATReal(1));
+		}
+		else
+		{
+			const FSATReal C = FSATVector2::DotProduct(D1, R);
+			if (E <= SMALL_NUMBER)
+			{
+				S = FMath::Clamp(-C / A, FSATReal(0), FSATReal(1));
+			}
+			else
+			{
+				const FSATReal B = FSATVector2::DotProduct(D1, D2);
+				const FSATReal Denom = A * E - B * B;
+
+				// Parallel segments pick an arbitrary S, T then corrects it
+				S = Denom > SMALL_NUMBER ? FMath::Clamp((B * F - C * E) / Denom, FSATReal(0), FSATReal(1)) : 0.f;
+				T = (B * S + F) / E;
+
+				if (T < 0.f)
+				{
+					T = 0.f;
+					S = FMath::Clamp(-C / A, FSATReal(0), FSATReal(1));
+				}
+				else if (T > 1.f)
+				{
+					T = 1.f;
+					S = FMath::Clamp((B - C) / A, FSATReal(0), FSATReal(1));
+				}
+			}
+		}
+
+		OutC1 = P1 + D1 * S;
+		OutC2 = P2 + D2 * T;
+	}
+
+	// FMath::ClosestPointOnSegment2D in the pipeline's precision
+	FSATVector2 ClosestPointOnSegment(const FSATVector2& Point, const FSATVector2& Start, const FSATVector2& End)
+	{
+		const FSATVector2 Segment = End - Start;
+		const FSATReal LengthSq = Segment.SizeSquared();
+		if (LengthSq <= SMALL_NUMBER) return Start;
+
+		const FSATReal T = FMath::Clamp(FSATVector2::DotProduct(Point - Start, Segment) / LengthSq, FSATReal(0), FSATReal(1));
+		return Start + Segment * T;
+	}
+
+	TAutoConsoleVariable<bool> CVarSATContactPoints(
+		TEXT("SAT.ContactPoints"),
+		true,
+		TEXT("Whether the narrow phase clips contact points for each colliding pair, see USATCollisionSubsystem::GetContact."));
+
+	TAutoConsoleVariable<bool> CVarSATAsyncDetection(
+		TEXT("SAT.AsyncDetection"),
+		false,
+		TEXT("Runs detection on a background task that overlaps the next frame's gameplay. ")
+		TEXT("Events and Block resolution then arrive one frame late. All worlds in the process are detected in one batch."));
+
+	TAutoConsoleVariable<float> CVarSATWorldBudgetMs(
+		TEXT("SAT.WorldBudgetMs"),
+		0.f,
+		TEXT("Detection time per world and tick, in ms. Far shapes (see SAT.LODDistance) beyond what fits are pushed to the next tick, ")
+		TEXT("and a world whose average is still over it stops generating contact points. 0 disables the budget."));
+
+	TAutoConsoleVariable<float> CVarSATLODDistance(
+		TEXT("SAT.LODDistance"),
+		0.f,
+		TEXT("Shapes further than this from every player's view point are only tested every SAT.LODInterval ticks. 0 tests every shape every tick."));
+
+	TAutoConsoleVariable<int32> CVarSATLODInterval(
+		TEXT("SAT.LODInterval"),
+		4,
+		TEXT("Ticks between tests of a shape beyond SAT.LODDistance. Far shapes are spread evenly over these ticks."));
+
+	FAutoConsoleCommandWithWorld GSATMemoryReportCommand(
+		TEXT("SAT.MemoryReport"),
+		TEXT("Logs the outline memory held by this world's SAT polygons."),
+		FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			if (const USATCollisionSubsystem* SAT = World ? World->GetSubsystem<USATCollisionSubsystem>() : nullptr)
+			{
+				SAT->LogMemoryReport();
+			}
+		}));
+
+	FAutoConsoleCommand GSATWorldStatsCommand(
+		TEXT("SAT.WorldStats"),
+		TEXT("Logs the SAT collision cost of every world in the process."),
+		FConsoleCommandDelegate::CreateLambda([]()
+		{
+			if (!GEngine) return;
+
+			for (const FWorldContext& Context : GEngine->GetWorldContexts())
+			{
+				const UWorld* World = Context.World();
+				const USATCollisionSubsystem* SAT = World ? World->GetSubsystem<USATCollisionSubsystem>() : nullptr;
+				if (!SAT) continue;
+
+				const FSATWorldStats& Stats = SAT->GetWorldStats();
+				UE_LOG(LogTemp, Display, TEXT("%s: %d shapes (%d dormant), %d contacts, %.3f ms (avg %.3f ms, budget %.3f ms, %d frames over%s)"),
+				       *World->GetName(), Stats.NumShapes, Stats.NumDormantShapes, Stats.NumContacts, Stats.DetectMs, Stats.AverageDetectMs,
+				       SAT->GetDetectionBudget(), Stats.OverBudgetFrames, Stats.bSheddingContactPoints ? TEXT(", shedding contact points") : TEXT(""));
+			}
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs GSATStartRecordingCommand(
+		TEXT("SAT.StartRecording"),
+		TEXT("Records the SAT collision state of every tick to a file. Usage: SAT.StartRecording [File]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			USATCollisionSubsystem* SAT = World ? World->GetSubsystem<USATCollisionSubsystem>() : nullptr;
+			if (!SAT) return;
+
+			const FString Filename = Args.Num() > 0
+				? Args[0]
+				: FPaths::ProjectSavedDir() / TEXT("SATRecordings") / FDateTime::Now().ToString() + TEXT(".satrec");
+			SAT->StartRecording(Filename);
+		}));
+
+	FAutoConsoleCommandWithWorldAndArgs GSATStopRecordingCommand(
+		TEXT("SAT.StopRecording"),
+		TEXT("Stops a recording started with SAT.StartRecording."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (USATCollisionSubsystem* SAT = World ? World->GetSubsystem<USATCollisionSubsystem>() : nullptr)
+			{
+				SAT->StopRecording();
+			}
+		}));
+}
 
 void USATCollisionSubsystem::RegisterPolygon(APolygon2D* Polygon)
 {
-	PolygonActors.AddUnique(Polygon);
+	PolygonActors.Add(Polygon);
+	ActorsById.Add(Polygon->GetUniqueID(), Polygon);
 }
 
 void USATCollisionSubsystem::UnregisterPolygon(APolygon2D* Polygon)
 {
 	PolygonActors.Remove(Polygon);
+	ActorsById.Remove(Polygon->GetUniqueID());
 }
 
 void USATCollisionSubsystem::RegisterCircle(ACircle2D* Circle)
 {
-	CircleActors.AddUnique(Circle);
+	CircleActors.Add(Circle);
+	ActorsById.Add(Circle->GetUniqueID(), Circle);
+}
+
+void USATCollisionSubsystem::UnregisterCircle(ACircle2D* Circle)
+{
+	CircleActors.Remove(Circle);
+	ActorsById.Remove(Circle->GetUniqueID());
+}
+
+void USATCollisionSubsystem::RegisterCapsule(ACapsule2D* Capsule)
+{
+	CapsuleActors.Add(Capsule);
+	ActorsById.Add(Capsule->GetUniqueID(), Capsule);
+}
+
+void USATCollisionSubsystem::UnregisterCapsule(ACapsule2D* Capsule)
+{
+	CapsuleActors.Remove(Capsule);
+	ActorsById.Remove(Capsule->GetUniqueID());
+}
+
+void USATCollisionSubsystem::RegisterBox(AOrientedBox2D* Box)
+{
+	BoxActors.Add(Box);
+	ActorsById.Add(Box->GetUniqueID(), Box);
+}
+
+void USATCollisionSubsystem::UnregisterBox(AOrientedBox2D* Box)
+{
+	BoxActors.Remove(Box);
+	ActorsById.Remove(Box->GetUniqueID());
+}
+
+void USATCollisionSubsystem::ProjectPolygonOntoAxis(const TArray<FVector2D>& Points, const FVector2D& Axis,
+	float& OutMin, float& OutMax)
+{
+	
+	OutMin = FVector2D::DotProduct(Points[0], Axis);
+	OutMax = OutMin;
+
+	for (size_t i = 1; i < Points.Num(); ++i)
+	{
+		float Projection = FVector2D::DotProduct(Points[i], Axis);
+		OutMin = FMath::Min(OutMin, Projection);
+		OutMax = FMath::Max(OutMax, Projection);
+	}
+}
+
+void USATCollisionSubsystem::ProjectOntoAxis(const TArray<FSATVector2>& Points, const FSATVector2& Axis,
+	FSATReal& OutMin, FSATReal& OutMax)
+{
+	OutMin = FSATVector2::DotProduct(Points[0], Axis);
+	OutMax = OutMin;
+
+	for (int32 i = 1; i < Points.Num(); ++i)
+	{
+		const FSATReal Projection = FSATVector2::DotProduct(Points[i], Axis);
+		OutMin = FMath::Min(OutMin, Projection);
+		OutMax = FMath::Max(OutMax, Projection);
+	}
+}
+
+void USATCollisionSubsystem::Deinitialize()
+{
+	// Results of an in-flight detection are dropped along with the world, but the batch must be
+	// done with the job before it goes away
+	FSATDetectionBatch::Get().Cancel(PendingJob);
+	PendingJob.bResultsReady = false;
+
+	StopRecording();
+
+	Super::Deinitialize();
+}
+
+bool USATCollisionSubsystem::StartRecording(const FString& Filename)
+{
+	RecordedOverlapIds.Reset();
+	return Recorder.Open(Filename);
+}
+
+void USATCollisionSubsystem::StopRecording()
+{
+	Recorder.Close();
+}
+
+bool USATCollisionSubsystem::GetContact(const AActor* Actor, const AActor* Other, FSATContact& OutContact) const
+{
+	if (const FSATContact* Contact = Contacts.Find(MakeTuple(Actor, Other)))
+	{
+		OutContact = *Contact;
+		return true;
+	}
+
+	if (const FSATContact* Contact = Contacts.Find(MakeTuple(Other, Actor)))
+	{
+		OutContact = *Contact;
+		OutContact.Axis = -OutContact.Axis;
+		return true;
+	}
+
+	return false;
+}
+
+void USATCollisionSubsystem::GatherFrameState(FSATFrameState& Frame, TArray<AActor*>& OutActors)
+{
+	const int32 NumShapes = PolygonActors.Num() + CircleActors.Num() + CapsuleActors.Num() + BoxActors.Num();
+	Frame.Shapes.Reserve(NumShapes);
+	OutActors.Reserve(NumShapes);
+
+	for (const TWeakObjectPtr<APolygon2D>& PolyActor : PolygonActors)
+	{
+		APolygon2D* Polygon = PolyActor.Get();
+		if (PolyActor.IsStale()) PolygonActors.MarkStale();
+		if (!IsValid(Polygon)) continue;
+
+		FSATShapeState& Shape = Frame.Shapes.AddDefaulted_GetRef();
+		Shape.Id = Polygon->GetUniqueID();
+		Shape.ScheduleSlot = Polygon->SATScheduleSlot;
+		Shape.Type = ESATShapeType::Polygon;
+		Shape.Response = Polygon->CollisionResponse;
+		Shape.Transform = Polygon->GetActorTransform();
+		if (Polygon->Hull && Polygon->Hull->GetHull().IsValid())
+		{
+			Shape.Hull = Polygon->Hull->GetHull();
+		}
+		else
+		{
+			Shape.Points = Polygon->Points;
+		}
+		OutActors.Add(Polygon);
+	}
+
+	for (const TWeakObjectPtr<ACircle2D>& CircleActor : CircleActors)
+	{
+		ACircle2D* Circle = CircleActor.Get();
+		if (CircleActor.IsStale()) CircleActors.MarkStale();
+		if (!IsValid(Circle)) continue;
+
+		FSATShapeState& Shape = Frame.Shapes.AddDefaulted_GetRef();
+		Shape.Id = Circle->GetUniqueID();
+		Shape.ScheduleSlot = Circle->SATScheduleSlot;
+		Shape.Type = ESATShapeType::Circle;
+		Shape.Response = Circle->CollisionResponse;
+		Shape.Transform = Circle->GetActorTransform();
+		Shape.Center = Circle->GetWorldCenter();
+		Shape.Radius = Circle->GetWorldRadius();
+		OutActors.Add(Circle);
+	}
+
+	for (const TWeakObjectPtr<ACapsule2D>& CapsuleActor : CapsuleActors)
+	{
+		ACapsule2D* Capsule = CapsuleActor.Get();
+		if (CapsuleActor.IsStale()) CapsuleActors.MarkStale();
+		if (!IsValid(Capsule)) continue;
+
+		FSATShapeState& Shape = Frame.Shapes.AddDefaulted_GetRef();
+		Shape.Id = Capsule->GetUniqueID();
+		Shape.ScheduleSlot = Capsule->SATScheduleSlot;
+		Shape.Type = ESATShapeType::Capsule;
+		Shape.Response = Capsule->CollisionResponse;
+		Shape.Transform = Capsule->GetActorTransform();
+		Shape.Points = { Capsule->GetWorldStart(), Capsule->GetWorldEnd() };
+		Shape.Radius = Capsule->GetWorldRadius();
+		OutActors.Add(Capsule);
+	}
+
+	for (const TWeakObjectPtr<AOrientedBox2D>& BoxActor : BoxActors)
+	{
+		AOrientedBox2D* Box = BoxActor.Get();
+		if (BoxActor.IsStale()) BoxActors.MarkStale();
+		if (!IsValid(Box)) continue;
+
+		FSATShapeState& Shape = Frame.Shapes.AddDefaulted_GetRef();
+		Shape.Id = Box->GetUniqueID();
+		Shape.ScheduleSlot = Box->SATScheduleSlot;
+		Shape.Type = ESATShapeType::Box;
+		Shape.Response = Box->CollisionResponse;
+		Shape.Transform = Box->GetActorTransform();
+		Shape.Center = Box->GetWorldCenter();
+		Shape.HalfExtents = Box->GetWorldHalfExtents();
+		Shape.AxisX = Box->GetWorldAxisX();
+		OutActors.Add(Box);
+	}
+}
+
+void USATCollisionSubsystem::ScheduleShapes(FSATFrameState& Frame, const TArray<AActor*>& FrameActors)
+{
+	WorldStats.NumDormantShapes = 0;
+
+	const float LODDistance = CVarSATLODDistance.GetValueOnGameThread();
+	if (LODDistance <= 0.f) return;
+
+	TArray<FVector2D, TInlineAllocator<4>> ViewPoints;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			FVector Location;
+			FRotator Rotation;
+			PlayerController->GetPlayerViewPoint(Location, Rotation);
+			ViewPoints.Add(FVector2D(Location));
+		}
+	}
+
+	// Nobody to be far from, e.g. in editor worlds
+	if (ViewPoints.Num() == 0) return;
+
+	const int32 Interval = FMath::Max(CVarSATLODInterval.GetValueOnGameThread(), 1);
+	const float BudgetMs = GetDetectionBudget();
+	const bool bBudgeted = BudgetMs > 0.f && WorldStats.MsPerTestedShape > 0.f;
+	if (Interval == 1 && !bBudgeted) return;
+
+	const double LODDistanceSq = FMath::Square(LODDistance);
+	TArray<int32> FarShapes;
+	for (int32 i = 0; i < Frame.Shapes.Num(); ++i)
+	{
+		const FVector2D Location(FrameActors[i]->GetActorLocation());
+		const bool bNear = Algo::AnyOf(ViewPoints, [&Location, LODDistanceSq](const FVector2D& ViewPoint)
+		{
+			return FVector2D::DistSquared(Location, ViewPoint) <= LODDistanceSq;
+		});
+
+		if (!bNear)
+		{
+			FarShapes.Add(i);
+		}
+	}
+
+	if (FarShapes.Num() == 0) return;
+
+	// Round robin by registration order. Ids are object slots, which can all land in the same few
+	// buckets.
+	FarShapes.Sort([&Frame](int32 A, int32 B)
+	{
+		return Frame.Shapes[A].ScheduleSlot < Frame.Shapes[B].ScheduleSlot;
+	});
+
+	// An even share of the far shapes each tick, so each is tested every Interval ticks
+	int32 NumTested = FMath::DivideAndRoundUp(FarShapes.Num(), Interval);
+	if (bBudgeted)
+	{
+		// Near shapes are always tested. Far ones get what the budget has left at the last detection's
+		// cost per tested shape, and at least one so every far shape is still tested eventually.
+		const int32 NumNear = Frame.Shapes.Num() - FarShapes.Num();
+		const int32 NumAffordable = FMath::FloorToInt32(BudgetMs / WorldStats.MsPerTestedShape) - NumNear;
+		NumTested = FMath::Clamp(NumAffordable, 1, NumTested);
+	}
+
+	// Carry on after the last far shape tested, so the ones that didn't fit are first next tick
+	const int32 First = Algo::LowerBoundBy(FarShapes, LODCursor, [&Frame](int32 Index)
+	{
+		return Frame.Shapes[Index].ScheduleSlot;
+	}) % FarShapes.Num();
+
+	for (int32 n = 0; n < FarShapes.Num(); ++n)
+	{
+		FSATShapeState& Shape = Frame.Shapes[FarShapes[(First + n) % FarShapes.Num()]];
+		if (n < NumTested)
+		{
+			LODCursor = Shape.ScheduleSlot + 1;
+			continue;
+		}
+
+		Shape.bDormant = true;
+		++WorldStats.NumDormantShapes;
+	}
+}
+
+void USATCollisionSubsystem::DetectCollisions(FSATFrameState& Frame, FSATBroadPhase* BroadPhase)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SATDetectCollisions);
+
+	TArray<int32> Collidable;
+	Collidable.Reserve(Frame.Shapes.Num());
+
+	for (int32 i = 0; i < Frame.Shapes.Num(); ++i)
+	{
+		FSATShapeState& Shape = Frame.Shapes[i];
+		Shape.UpdateWorldData();
+
+		if (Shape.Response != ESATCollisionResponse::Ignore && Shape.HasArea())
+		{
+			Collidable.Add(i);
+		}
+	}
+
+	TArray<TPair<int32, int32>> Pairs;
+	if (BroadPhase)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SATBroadPhase);
+		BroadPhase->UpdatePairs(Frame, Collidable, Pairs);
+
+		// Two dormant shapes keep what they had last frame, so their overlap neither begins nor ends
+		// until one of them is due again. Nothing is resolved for them since that was done back then.
+		// Their contacts are carried by id rather than through Pairs, so they don't depend on the
+		// tree's fat bounds and a replay with a fresh tree carries the same ones.
+		Pairs.RemoveAll([&Frame](const TPair<int32, int32>& Pair)
+		{
+			return Frame.Shapes[Pair.Key].bDormant && Frame.Shapes[Pair.Value].bDormant;
+		});
+		BroadPhase->AddLastContacts(Frame);
+	}
+	else
+	{
+		// Without a persistent broad phase every collidable pair goes to the narrow phase
+		for (int32 i = 0; i < Collidable.Num(); ++i)
+		{
+			for (int32 j = i + 1; j < Collidable.Num(); ++j)
+			{
+				Pairs.Emplace(Collidable[i], Collidable[j]);
+			}
+		}
+	}
+
+	// Bucket the pairs by type combination, with the lower type first since kernels only exist for
+	// TypeA <= TypeB. The sort is stable so each bucket keeps the broad phase's order.
+	constexpr int32 NumBuckets = SATNumShapeTypes * SATNumShapeTypes;
+	int32 BucketStart[NumBuckets + 1] = {};
+
+	for (TPair<int32, int32>& Pair : Pairs)
+	{
+		if (Frame.Shapes[Pair.Value].Type < Frame.Shapes[Pair.Key].Type)
+		{
+			Swap(Pair.Key, Pair.Value);
+		}
+		++BucketStart[PairBucket(Frame, Pair) + 1];
+	}
+
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		BucketStart[Bucket + 1] += BucketStart[Bucket];
+	}
+
+	TArray<TPair<int32, int32>> SortedPairs;
+	SortedPairs.SetNumUninitialized(Pairs.Num());
+	{
+		int32 Write[NumBuckets];
+		FMemory::Memcpy(Write, BucketStart, sizeof(Write));
+		for (const TPair<int32, int32>& Pair : Pairs)
+		{
+			SortedPairs[Write[PairBucket(Frame, Pair)]++] = Pair;
+		}
+	}
+
+	// One dispatch per type combination
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		const int32 Count = BucketStart[Bucket + 1] - BucketStart[Bucket];
+		if (Count == 0) continue;
+
+		const FCollidePairsFunction CollideFunction = CollidePairsTable[Bucket / SATNumShapeTypes][Bucket % SATNumShapeTypes];
+		CollideFunction(Frame, TConstArrayView<TPair<int32, int32>>(SortedPairs.GetData() + BucketStart[Bucket], Count));
+	}
+
+	if (BroadPhase)
+	{
+		BroadPhase->StoreContacts(Frame);
+	}
+}
+
+FSATContact& USATCollisionSubsystem::AddContact(FSATFrameState& Frame, int32 ShapeA, int32 ShapeB,
+                                                const FSATVector2& Axis, FSATReal Overlap)
+{
+	FSATContact& Contact = Frame.Contacts.AddDefaulted_GetRef();
+	Contact.ShapeA = ShapeA;
+	Contact.ShapeB = ShapeB;
+	Contact.Axis = FVector2D(Axis);
+	Contact.Overlap = Overlap;
+	return Contact;
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Polygon, ESATShapeType::Polygon>(FSATFrameState& Frame, int32 IndexA, int32 IndexB)
+{
+	FSATShapeState& A = Frame.Shapes[IndexA];
+	FSATShapeState& B = Frame.Shapes[IndexB];
+
+	FSATContact Contact;
+	if (CheckSATCollision(A, B, Frame.bGenerateContactPoints, Contact))
+	{
+		Contact.ShapeA = IndexA;
+		Contact.ShapeB = IndexB;
+		Frame.Contacts.Add(Contact);
+
+		ApplySplitMTV(A, B, FSATVector2(Contact.Axis), Contact.Overlap);
+	}
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Polygon, ESATShapeType::Circle>(FSATFrameState& Frame, int32 PolygonIndex, int32 CircleIndex)
+{
+	FSATShapeState& Polygon = Frame.Shapes[PolygonIndex];
+	FSATShapeState& Circle = Frame.Shapes[CircleIndex];
+
+	FSATVector2 Axis;
+	FSATReal Overlap;
+	if (CheckCirclePolygonCollision(Circle, Polygon, Axis, Overlap))
+	{
+		FSATContact& Contact = AddContact(Frame, PolygonIndex, CircleIndex, Axis, Overlap);
+		if (Frame.bGenerateContactPoints)
+		{
+			Contact.NumPoints = 1;
+			Contact.Points[0].Position = Circle.ToWorld(Circle.WorldCenter - Axis * (Circle.Radius - 0.5f * Overlap));
+			Contact.Points[0].Depth = Overlap;
+		}
+
+		ApplySplitMTV(Polygon, Circle, Axis, Overlap);
+	}
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Polygon, ESATShapeType::Capsule>(FSATFrameState& Frame, int32 PolygonIndex, int32 CapsuleIndex)
+{
+	FSATShapeState& Polygon = Frame.Shapes[PolygonIndex];
+	FSATShapeState& Capsule = Frame.Shapes[CapsuleIndex];
+
+	FSATVector2 Axis;
+	FSATReal Overlap;
+	int32 Edge;
+	if (CheckCapsulePolygonCollision(Capsule, Polygon, Axis, Overlap, Edge))
+	{
+		FSATContact& Contact = AddContact(Frame, PolygonIndex, CapsuleIndex, Axis, Overlap);
+		if (Frame.bGenerateContactPoints)
+		{
+			AddCapsulePolygonContactPoints(Capsule, Polygon, Edge, Axis, Contact);
+		}
+
+		ApplySplitMTV(Polygon, Capsule, Axis, Overlap);
+	}
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Polygon, ESATShapeType::Box>(FSATFrameState& Frame, int32 PolygonIndex, int32 BoxIndex)
+{
+	// A box is a four-point polygon to the general SAT
+	Collide<ESATShapeType::Polygon, ESATShapeType::Polygon>(Frame, PolygonIndex, BoxIndex);
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Circle, ESATShapeType::Circle>(FSATFrameState& Frame, int32 IndexA, int32 IndexB)
+{
+	FSATShapeState& A = Frame.Shapes[IndexA];
+	FSATShapeState& B = Frame.Shapes[IndexB];
+
+	FSATVector2 Axis;
+	FSATReal Overlap;
+	if (CheckCircleCollision(A.WorldCenter, A.Radius, B.WorldCenter, B.Radius, Axis, Overlap))
+	{
+		FSATContact& Contact = AddContact(Frame, IndexA, IndexB, Axis, Overlap);
+		if (Frame.bGenerateContactPoints)
+		{
+			Contact.NumPoints = 1;
+			Contact.Points[0].Position = A.ToWorld(A.WorldCenter + Axis * (A.Radius - 0.5f * Overlap));
+			Contact.Points[0].Depth = Overlap;
+		}
+
+		ApplyCircleCircleMTV(A, B, Axis, Overlap);
+	}
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Circle, ESATShapeType::Capsule>(FSATFrameState& Frame, int32 CircleIndex, int32 CapsuleIndex)
+{
+	FSATShapeState& Circle = Frame.Shapes[CircleIndex];
+	FSATShapeState& Capsule = Frame.Shapes[CapsuleIndex];
+
+	// A capsule is a circle centered on the closest point of its segment
+	const FSATVector2 Closest = ClosestPointOnSegment(Circle.WorldCenter, Capsule.WorldPoints[0], Capsule.WorldPoints[1]);
+
+	FSATVector2 Axis;
+	FSATReal Overlap;
+	if (CheckCircleCollision(Circle.WorldCenter, Circle.Radius, Closest, Capsule.Radius, Axis, Overlap))
+	{
+		// With the center on the segment, the closest point gives no usable direction. Push out sideways.
+		const FSATVector2 Direction = (Capsule.WorldPoints[1] - Capsule.WorldPoints[0]).GetSafeNormal();
+		if (FSATVector2::DistSquared(Circle.WorldCenter, Closest) <= KINDA_SMALL_NUMBER && !Direction.IsZero())
+		{
+			Axis = FSATVector2(-Direction.Y, Direction.X);
+			Overlap = Circle.Radius + Capsule.Radius;
+		}
+
+		FSATContact& Contact = AddContact(Frame, CircleIndex, CapsuleIndex, Axis, Overlap);
+		if (Frame.bGenerateContactPoints)
+		{
+			Contact.NumPoints = 1;
+			Contact.Points[0].Position = Circle.ToWorld(Circle.WorldCenter + Axis * (Circle.Radius - 0.5f * Overlap));
+			Contact.Points[0].Depth = Overlap;
+		}
+
+		ApplySplitMTV(Circle, Capsule, Axis, Overlap);
+	}
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Circle, ESATShapeType::Box>(FSATFrameState& Frame, int32 CircleIndex, int32 BoxIndex)
+{
+	FSATShapeState& Circle = Frame.Shapes[CircleIndex];
+	FSATShapeState& Box = Frame.Shapes[BoxIndex];
+
+	FSATVector2 Axis;
+	FSATReal Overlap;
+	if (CheckCircleBoxCollision(Circle, Box, Axis, Overlap))
+	{
+		// Axis points from the box to the circle, the contact from the circle to the box
+		FSATContact& Contact = AddContact(Frame, CircleIndex, BoxIndex, -Axis, Overlap);
+		if (Frame.bGenerateContactPoints)
+		{
+			Contact.NumPoints = 1;
+			Contact.Points[0].Position = Circle.ToWorld(Circle.WorldCenter - Axis * (Circle.Radius - 0.5f * Overlap));
+			Contact.Points[0].Depth = Overlap;
+		}
+
+		ApplySplitMTV(Circle, Box, -Axis, Overlap);
+	}
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Capsule, ESATShapeType::Capsule>(FSATFrameState& Frame, int32 IndexA, int32 IndexB)
+{
+	FSATShapeState& A = Frame.Shapes[IndexA];
+	FSATShapeState& B = Frame.Shapes[IndexB];
+
+	FSATVector2 Axis;
+	FSATReal Overlap;
+	FSATVector2 PointA;
+	if (CheckCapsuleCollision(A, B, Axis, Overlap, PointA))
+	{
+		FSATContact& Contact = AddContact(Frame, IndexA, IndexB, Axis, Overlap);
+		if (Frame.bGenerateContactPoints)
+		{
+			Contact.NumPoints = 1;
+			Contact.Points[0].Position = A.ToWorld(PointA + Axis * (A.Radius - 0.5f * Overlap));
+			Contact.Points[0].Depth = Overlap;
+		}
+
+		ApplySplitMTV(A, B, Axis, Overlap);
+	}
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Capsule, ESATShapeType::Box>(FSATFrameState& Frame, int32 CapsuleIndex, int32 BoxIndex)
+{
+	FSATShapeState& Capsule = Frame.Shapes[CapsuleIndex];
+	FSATShapeState& Box = Frame.Shapes[BoxIndex];
+
+	FSATVector2 Axis;
+	FSATReal Overlap;
+	int32 Edge;
+	if (CheckCapsulePolygonCollision(Capsule, Box, Axis, Overlap, Edge))
+	{
+		// Axis points from the box to the capsule, the contact from the capsule to the box
+		FSATContact& Contact = AddContact(Frame, CapsuleIndex, BoxIndex, -Axis, Overlap);
+		if (Frame.bGenerateContactPoints)
+		{
+			AddCapsulePolygonContactPoints(Capsule, Box, Edge, Axis, Contact);
+		}
+
+		ApplySplitMTV(Capsule, Box, -Axis, Overlap);
+	}
+}
+
+template <>
+void USATCollisionSubsystem::Collide<ESATShapeType::Box, ESATShapeType::Box>(FSATFrameState& Frame, int32 IndexA, int32 IndexB)
+{
+	FSATShapeState& A = Frame.Shapes[IndexA];
+	FSATShapeState& B = Frame.Shapes[IndexB];
+
+	FSATContact Contact;
+	if (CheckBoxCollision(A, B, Frame.bGenerateContactPoints, Contact))
+	{
+		Contact.ShapeA = IndexA;
+		Contact.ShapeB = IndexB;
+		Frame.Contacts.Add(Contact);
+
+		ApplySplitMTV(A, B, FSATVector2(Contact.Axis), Contact.Overlap);
+	}
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Polygon, ESATShapeType::Polygon>(const FSATShapeState& A, const FSATShapeState& B)
+{
+	return !HasSeparatingFace(A, B) && !HasSeparatingFace(B, A);
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Polygon, ESATShapeType::Circle>(const FSATShapeState& Polygon, const FSATShapeState& Circle)
+{
+	return TestCirclePolygonOverlap(Circle, Polygon);
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Polygon, ESATShapeType::Capsule>(const FSATShapeState& Polygon, const FSATShapeState& Capsule)
+{
+	return TestCapsulePolygonOverlap(Capsule, Polygon);
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Polygon, ESATShapeType::Box>(const FSATShapeState& Polygon, const FSATShapeState& Box)
+{
+	return TestOverlap<ESATShapeType::Polygon, ESATShapeType::Polygon>(Polygon, Box);
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Circle, ESATShapeType::Circle>(const FSATShapeState& A, const FSATShapeState& B)
+{
+	const FSATReal RadiusSum = A.Radius + B.Radius;
+	return FSATVector2::DistSquared(A.WorldCenter, B.WorldCenter) <= RadiusSum * RadiusSum;
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Circle, ESATShapeType::Capsule>(const FSATShapeState& Circle, const FSATShapeState& Capsule)
+{
+	const FSATVector2 Closest = ClosestPointOnSegment(Circle.WorldCenter, Capsule.WorldPoints[0], Capsule.WorldPoints[1]);
+	const FSATReal RadiusSum = Circle.Radius + Capsule.Radius;
+	return FSATVector2::DistSquared(Circle.WorldCenter, Closest) <= RadiusSum * RadiusSum;
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Circle, ESATShapeType::Box>(const FSATShapeState& Circle, const FSATShapeState& Box)
+{
+	// Distance from the center to the box along each box axis, zero inside the extents
+	const FSATVector2 Delta = Circle.WorldCenter - Box.WorldCenter;
+	const FSATReal OutsideX = FMath::Max(FMath::Abs(FSATVector2::DotProduct(Delta, Box.WorldAxes[0])) - Box.WorldHalfExtents.X, FSATReal(0));
+	const FSATReal OutsideY = FMath::Max(FMath::Abs(FSATVector2::DotProduct(Delta, Box.WorldAxes[1])) - Box.WorldHalfExtents.Y, FSATReal(0));
+	return OutsideX * OutsideX + OutsideY * OutsideY <= Circle.Radius * Circle.Radius;
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Capsule, ESATShapeType::Capsule>(const FSATShapeState& A, const FSATShapeState& B)
+{
+	FSATVector2 PointA;
+	FSATVector2 PointB;
+	ClosestPointsBetweenSegments(A.WorldPoints[0], A.WorldPoints[1], B.WorldPoints[0], B.WorldPoints[1], PointA, PointB);
+
+	const FSATReal RadiusSum = A.Radius + B.Radius;
+	return FSATVector2::DistSquared(PointA, PointB) <= RadiusSum * RadiusSum;
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Capsule, ESATShapeType::Box>(const FSATShapeState& Capsule, const FSATShapeState& Box)
+{
+	return TestCapsulePolygonOverlap(Capsule, Box);
+}
+
+template <>
+bool USATCollisionSubsystem::TestOverlap<ESATShapeType::Box, ESATShapeType::Box>(const FSATShapeState& A, const FSATShapeState& B)
+{
+	const FSATVector2 Delta = B.WorldCenter - A.WorldCenter;
+
+	FSATReal R[2][2];
+	for (int32 i = 0; i < 2; ++i)
+	{
+		for (int32 j = 0; j < 2; ++j)
+		{
+			R[i][j] = FMath::Abs(FSATVector2::DotProduct(A.WorldAxes[i], B.WorldAxes[j]));
+		}
+	}
+
+	for (int32 i = 0; i < 2; ++i)
+	{
+		const FSATReal Extent = A.WorldHalfExtents[i] + B.WorldHalfExtents.X * R[i][0] + B.WorldHalfExtents.Y * R[i][1];
+		if (FMath::Abs(FSATVector2::DotProduct(Delta, A.WorldAxes[i])) > Extent) return false;
+	}
+
+	for (int32 j = 0; j < 2; ++j)
+	{
+		const FSATReal Extent = B.WorldHalfExtents[j] + A.WorldHalfExtents.X * R[0][j] + A.WorldHalfExtents.Y * R[1][j];
+		if (FMath::Abs(FSATVector2::DotProduct(Delta, B.WorldAxes[j])) > Extent) return false;
+	}
+
+	return true;
+}
+
+template <ESATShapeType TypeA, ESATShapeType TypeB>
+void USATCollisionSubsystem::CollidePairs(FSATFrameState& Frame, TConstArrayView<TPair<int32, int32>> Pairs)
+{
+	for (const TPair<int32, int32>& Pair : Pairs)
+	{
+		// Both shapes of a pair are tested relative to the same origin, the one of the region their
+		// bounds overlap in, so the points near the contact are the precise ones. Rebasing rounds the
+		// points to float again, so points far from the overlap, e.g. the far side of a large hull,
+		// lose a little precision.
+		FSATShapeState& ShapeA = Frame.Shapes[Pair.Key];
+		FSATShapeState& ShapeB = Frame.Shapes[Pair.Value];
+		const FBox2D Overlap = ShapeA.WorldBounds.Overlap(ShapeB.WorldBounds);
+		const FVector2D Origin = GetSATRegionOrigin(Overlap.bIsValid ? Overlap.GetCenter()
+		                                                             : 0.5 * (ShapeA.WorldBounds.GetCenter() + ShapeB.WorldBounds.GetCenter()));
+		if (ShapeA.Origin != Origin)
+		{
+			ShapeA.Rebase(Origin);
+		}
+		if (ShapeB.Origin != Origin)
+		{
+			ShapeB.Rebase(Origin);
+		}
+
+		// Only a pair that has to be pushed apart needs the full contact, everything else just
+		// needs to know whether it overlaps
+		if (ShapeA.Response == ESATCollisionResponse::Block || ShapeB.Response == ESATCollisionResponse::Block)
+		{
+			Collide<TypeA, TypeB>(Frame, Pair.Key, Pair.Value);
+		}
+		else if (TestOverlap<TypeA, TypeB>(ShapeA, ShapeB))
+		{
+			AddContact(Frame, Pair.Key, Pair.Value, FSATVector2::ZeroVector, 0.f);
+		}
+	}
+}
+
+// Adding a shape type means adding its Collide specialisations and a row and column here
+const USATCollisionSubsystem::FCollidePairsFunction USATCollisionSubsystem::CollidePairsTable[SATNumShapeTypes][SATNumShapeTypes] =
+{
+	{
+		&CollidePairs<ESATShapeType::Polygon, ESATShapeType::Polygon>,
+		&CollidePairs<ESATShapeType::Polygon, ESATShapeType::Circle>,
+		&CollidePairs<ESATShapeType::Polygon, ESATShapeType::Capsule>,
+		&CollidePairs<ESATShapeType::Polygon, ESATShapeType::Box>,
+	},
+	{
+		nullptr,
+		&CollidePairs<ESATShapeType::Circle, ESATShapeType::Circle>,
+		&CollidePairs<ESATShapeType::Circle, ESATShapeType::Capsule>,
+		&CollidePairs<ESATShapeType::Circle, ESATShapeType::Box>,
+	},
+	{
+		nullptr,
+		nullptr,
+		&CollidePairs<ESATShapeType::Capsule, ESATShapeType::Capsule>,
+		&CollidePairs<ESATShapeType::Capsule, ESATShapeType::Box>,
+	},
+	{
+		nullptr,
+		nullptr,
+		nullptr,
+		&CollidePairs<ESATShapeType::Box, ESATShapeType::Box>,
+	},
+};
+
+bool USATCollisionSubsystem::IsTickable() const
+{
+	if (IsTemplate()) return false;
+
+	return FSATDetectionBatch::HasResultsToApply(PendingJob)
+		|| PreviousOverlaps.Num() > 0
+		|| PolygonActors.Num() > 0
+		|| CircleActors.Num() > 0
+		|| CapsuleActors.Num() > 0
+		|| BoxActors.Num() > 0;
+}
+
+void USATCollisionSubsystem::LogMemoryReport() const
+{
+	int32 NumPolygons = 0;
+	int32 NumHullPolygons = 0;
+	SIZE_T OwnedBytes = 0;
+	TSet<const FSATHull*> Hulls;
+
+	for (const TWeakObjectPtr<APolygon2D>& PolyActor : PolygonActors)
+	{
+		const APolygon2D* Polygon = PolyActor.Get();
+		if (!Polygon) continue;
+
+		++NumPolygons;
+		const FSATHull* SharedHull = Polygon->Hull ? Polygon->Hull->GetHull().Get() : nullptr;
+		if (SharedHull)
+		{
+			++NumHullPolygons;
+			Hulls.Add(SharedHull);
+		}
+		else
+		{
+			OwnedBytes += Polygon->Points.GetAllocatedSize();
+		}
+	}
+
+	SIZE_T HullBytes = 0;
+	for (const FSATHull* SharedHull : Hulls)
+	{
+		HullBytes += sizeof(FSATHull) + SharedHull->GetAllocatedSize();
+	}
+
+	// Every gathered polygon without a hull also copies its points into the frame snapshot each tick
+	UE_LOG(LogTemp, Display, TEXT("%d polygons: %d with their own points (%llu bytes, copied again every tick), %d sharing %d hulls (%llu bytes)"),
+	       NumPolygons, NumPolygons - NumHullPolygons, static_cast<uint64>(OwnedBytes), NumHullPolygons, Hulls.Num(), static_cast<uint64>(HullBytes));
+}
+
+float USATCollisionSubsystem::GetDetectionBudget() const
+{
+	return DetectionBudgetMs >= 0.f ? DetectionBudgetMs : CVarSATWorldBudgetMs.GetValueOnGameThread();
+}
+
+void USATCollisionSubsystem::WaitForPendingJob()
+{
+	if (FSATDetectionBatch::IsPending(PendingJob))
+	{
+		FSATDetectionBatch::Get().Wait(PendingJob);
+	}
+}
+
+void USATCollisionSubsystem::UpdateWorldStats(const FSATFrameState& Frame, double DetectSeconds)
+{
+	WorldStats.NumShapes = Frame.Shapes.Num();
+	WorldStats.NumContacts = Frame.Contacts.Num();
+	WorldStats.DetectMs = DetectSeconds * 1000.0;
+	WorldStats.AverageDetectMs = FMath::Lerp(WorldStats.AverageDetectMs, WorldStats.DetectMs, 1.f / 30.f);
+
+	// What ScheduleShapes sizes the next ticks by. Smoothed over a few detections only, so it follows
+	// the world's cost closely without one hitch halving the far shapes tested.
+	const int32 NumTested = Algo::CountIf(Frame.Shapes, [](const FSATShapeState& Shape) { return !Shape.bDormant; });
+	const float MsPerTestedShape = WorldStats.DetectMs / FMath::Max(NumTested, 1);
+	WorldStats.MsPerTestedShape = WorldStats.MsPerTestedShape > 0.f ? FMath::Lerp(WorldStats.MsPerTestedShape, MsPerTestedShape, 0.25f) : MsPerTestedShape;
+
+	const float BudgetMs = GetDetectionBudget();
+	if (BudgetMs <= 0.f)
+	{
+		WorldStats.bSheddingContactPoints = false;
+		return;
+	}
+
+	if (WorldStats.DetectMs > BudgetMs)
+	{
+		++WorldStats.OverBudgetFrames;
+	}
+
+	// ScheduleShapes already caps the far shapes each tick. Contact points are the remaining cost
+	// that can be shed, for worlds whose near shapes alone are over budget. Some hysteresis so a
+	// world hovering around its budget doesn't toggle every frame.
+	if (!WorldStats.bSheddingContactPoints && WorldStats.AverageDetectMs > BudgetMs)
+	{
+		WorldStats.bSheddingContactPoints = true;
+		UE_LOG(LogTemp, Warning, TEXT("SAT collision in %s is over its %.2f ms budget (%.2f ms), skipping contact points"),
+		       *GetWorld()->GetName(), BudgetMs, WorldStats.AverageDetectMs);
+	}
+	else if (WorldStats.bSheddingContactPoints && WorldStats.AverageDetectMs < 0.8f * BudgetMs)
+	{
+		WorldStats.bSheddingContactPoints = false;
+		UE_LOG(LogTemp, Log, TEXT("SAT collision in %s is back within its %.2f ms budget"), *GetWorld()->GetName(), BudgetMs);
+	}
 }
 
-void USATCollisionSubsystem::UnregisterCircle(ACircle2D* Circle)
+void USATCollisionSubsystem::QueryShapes(const FBox2D& Bounds, TArray<AActor*>& OutActors)
 {
-	CircleActors.Remove(Circle);
-}
+	// The tree is updated by the detection job
+	WaitForPendingJob();
 
-void USATCollisionSubsystem::ProjectPolygonOntoAxis(const TArray<FVector2D>& Points, const FVector2D& Axis,
-	float& OutMin, float& OutMax)
-{
-	
-	OutMin = FVector2D::DotProduct(Points[0], Axis);
-	OutMax = OutMin;
+	TArray<uint32> Ids;
+	BroadPhase.Query(Bounds, Ids);
 
-	for (size_t i = 1; i < Points.Num(); ++i)
+	for (uint32 Id : Ids)
 	{
-		float Projection = FVector2D::DotProduct(Points[i], Axis);
-		OutMin = FMath::Min(OutMin, Projection);
-		OutMax = FMath::Max(OutMax, Projection);
+		if (AActor* Actor = ActorsById.FindRef(Id).Get())
+		{
+			OutActors.Add(Actor);
+		}
 	}
 }
 
 void USATCollisionSubsystem::Tick(float DeltaTime)
 {
-	TSet<AActor*> CollidingActors;
-	TSet<TPair<AActor*, AActor*>> CurrentOverlaps;
-	
-	// polygon-vs-polygon collisions
-	for (int32 i = 0; i < PolygonActors.Num(); ++i)
+	// Sync point for the frame detected in the background since the last tick. It may already have
+	// been waited for, e.g. by QueryShapes, in which case only its results are left to apply.
+	if (FSATDetectionBatch::HasResultsToApply(PendingJob))
 	{
-		APolygon2D* A = PolygonActors[i].Get();
-		if (!IsValid(A)) continue;
-		if (A->Points.Num() < 3 || A->CollisionResponse == ESATCollisionResponse::Ignore) continue;
+		{
+			SCOPE_CYCLE_COUNTER(STAT_SATSyncStall);
+			FSATDetectionBatch::Get().Wait(PendingJob);
+		}
+		SET_FLOAT_STAT(STAT_SATResultLatency, (FPlatformTime::Seconds() - PendingGatherTime) * 1000.0);
 
-		for (int32 j = i + 1; j < PolygonActors.Num(); ++j)
+		// Actors may have been destroyed while their frame was in flight
+		TArray<AActor*> FrameActors;
+		FrameActors.Reserve(PendingActors.Num());
+		for (const TWeakObjectPtr<AActor>& Actor : PendingActors)
 		{
-			APolygon2D* B = PolygonActors[j].Get();
-			if (!IsValid(B)) continue;
-			if (B->Points.Num() < 3 || B->CollisionResponse == ESATCollisionResponse::Ignore) continue;
+			FrameActors.Add(Actor.Get());
+		}
 
-			FVector2D Axis;
-			float Overlap;
-			if (CheckSATCollision(*A, A->GetActorTransform(),
-								  *B, B->GetActorTransform(),
-								  Axis, Overlap))
-			{
-				A->SetColliding(true);
-				B->SetColliding(true);
-				CollidingActors.Add(A);
-				CollidingActors.Add(B);
+		UpdateWorldStats(PendingJob.Frame, PendingJob.DetectSeconds);
+		ApplyFrameResults(PendingJob.Frame, FrameActors);
+		PendingActors.Reset();
+		PendingJob.bResultsReady = false;
+	}
 
-				TPair<AActor*, AActor*> Pair = MakeSortedPair(A, B);
-				CurrentOverlaps.Add(Pair);
+	// Registration only nulls slots, the holes are closed here where nothing is iterating them
+	int32 NumStale = 0;
+	if (PolygonActors.NeedsCompaction()) NumStale += PolygonActors.Compact();
+	if (CircleActors.NeedsCompaction()) NumStale += CircleActors.Compact();
+	if (CapsuleActors.NeedsCompaction()) NumStale += CapsuleActors.Compact();
+	if (BoxActors.NeedsCompaction()) NumStale += BoxActors.Compact();
 
-				if (!PreviousOverlaps.Contains(Pair))
-				{
-					A->OnSATOverlapBeginDelegate.Broadcast(B);
-					B->OnSATOverlapBeginDelegate.Broadcast(A);
-				}
-				
-				if (A->CollisionResponse == ESATCollisionResponse::Block
-					|| B->CollisionResponse == ESATCollisionResponse::Block)
-				{
-					ApplyPolygonMTV(*A, A->GetActorTransform(), *B, B->GetActorTransform());
-				}
-			}
+	// Actors destroyed without unregistering are still in ActorsById too
+	if (NumStale > 0)
+	{
+		for (auto It = ActorsById.CreateIterator(); It; ++It)
+		{
+			if (It.Value().IsStale()) It.RemoveCurrent();
 		}
 	}
 
-	// circle-vs-circle collisions
-	for (int32 i = 0; i < CircleActors.Num(); ++i)
-	{
-		ACircle2D* A = CircleActors[i].Get();
-		if (!IsValid(A)) continue;
-		if (A->Radius <= 0) continue;
+	FSATFrameState Frame;
+	Frame.FrameNumber = GFrameCounter;
+	Frame.DeltaTime = DeltaTime;
+	Frame.bGenerateContactPoints = CVarSATContactPoints.GetValueOnGameThread() && !WorldStats.bSheddingContactPoints;
+
+	TArray<AActor*> FrameActors;
+	GatherFrameState(Frame, FrameActors);
+	ScheduleShapes(Frame, FrameActors);
 
-		ESATCollisionResponse ResponseA = A->CollisionResponse;
-		if (ResponseA == ESATCollisionResponse::Ignore) continue;
-		
-		for (int32 j = i + 1; j < CircleActors.Num(); ++j)
+	if (CVarSATAsyncDetection.GetValueOnGameThread())
+	{
+		PendingActors.Reset(FrameActors.Num());
+		for (AActor* Actor : FrameActors)
 		{
-			ACircle2D* B = CircleActors[j].Get();
-			if (!IsValid(B)) continue;
-			if (B->Radius <= 0) continue;
+			PendingActors.Add(Actor);
+		}
 
-			ESATCollisionResponse ResponseB = B->CollisionResponse;
-			if (ResponseB == ESATCollisionResponse::Ignore) continue;
+		// DetectCollisions only reads and writes the frame and the broad phase, which nothing else
+		// touches until the sync point
+		PendingJob.Frame = MoveTemp(Frame);
+		PendingJob.BroadPhase = &BroadPhase;
+		PendingGatherTime = FPlatformTime::Seconds();
+		FSATDetectionBatch::Get().Enqueue(PendingJob);
+		return;
+	}
 
-			FVector2D Axis;
-			float Overlap;
-			if (CheckCircleCollision(*A, A->GetActorTransform(),
-										*B, B->GetActorTransform(),
-										Axis, Overlap)) // Assumes you have this
-			{
-				A->SetColliding(true);
-				B->SetColliding(true);
-				CollidingActors.Add(A);
-				CollidingActors.Add(B);
+	const double StartTime = FPlatformTime::Seconds();
+	DetectCollisions(Frame, &BroadPhase);
+	UpdateWorldStats(Frame, FPlatformTime::Seconds() - StartTime);
 
-				TPair<AActor*, AActor*> Pair = MakeSortedPair(A, B);
-				CurrentOverlaps.Add(Pair);
+	ApplyFrameResults(Frame, FrameActors);
+}
 
-				if (!PreviousOverlaps.Contains(Pair))
-				{
-					A->OnSATOverlapBeginDelegate.Broadcast(B);
-					B->OnSATOverlapBeginDelegate.Broadcast(A);
-				}
-				
-				if (ResponseA == ESATCollisionResponse::Block || ResponseB == ESATCollisionResponse::Block)
-				{
-					ApplyCircleCircleMTV(*A, *B, Axis, Overlap);
-				}
-			}
+void USATCollisionSubsystem::ApplyFrameResults(FSATFrameState& Frame, const TArray<AActor*>& FrameActors)
+{
+	// Push Block resolution back onto the actors
+	for (int32 i = 0; i < Frame.Shapes.Num(); ++i)
+	{
+		const FVector2D& Offset = Frame.Shapes[i].AppliedOffset;
+		if (FrameActors[i] && !Offset.IsZero())
+		{
+			FrameActors[i]->AddActorWorldOffset(FVector(Offset, 0.0f));
 		}
 	}
-	
-	// polygon-vs-circle collisions
-	for (TWeakObjectPtr<APolygon2D> PolyActor : PolygonActors)
-	{
-		APolygon2D* Polygon = PolyActor.Get();
-		if (!IsValid(Polygon)) continue;
-		if (Polygon->Points.Num() < 3) continue;
 
-		ESATCollisionResponse PolygonResponse = Polygon->CollisionResponse;
-		if (PolygonResponse == ESATCollisionResponse::Ignore) continue;
+	TSet<AActor*> CollidingActors;
+	TSet<TPair<AActor*, AActor*>> CurrentOverlaps;
 
-		for (TWeakObjectPtr<ACircle2D> CircleActor : CircleActors)
-		{
-			ACircle2D* Circle = CircleActor.Get();
-			if (!IsValid(Circle)) continue;
-			if (Circle->Radius <= 0) continue;
+	// Filled before any event fires so begin handlers can already query their contact
+	Contacts.Reset();
+	for (const FSATContact& Contact : Frame.Contacts)
+	{
+		if (!FrameActors[Contact.ShapeA] || !FrameActors[Contact.ShapeB]) continue;
+		Contacts.Add(TPair<const AActor*, const AActor*>(FrameActors[Contact.ShapeA], FrameActors[Contact.ShapeB]), Contact);
+	}
 
-			ESATCollisionResponse CircleResponse = Circle->CollisionResponse;
-			if (CircleResponse == ESATCollisionResponse::Ignore) continue;
+	for (const FSATContact& Contact : Frame.Contacts)
+	{
+		AActor* A = FrameActors[Contact.ShapeA];
+		AActor* B = FrameActors[Contact.ShapeB];
+		if (!A || !B) continue;
 
-			FVector2D Axis;
-			float Overlap;
-			if (CheckCirclePolygonCollision(*Circle, Circle->GetTransform(),
-											*Polygon, Polygon->GetActorTransform(),
-											Axis, Overlap)) // Assumes this too
-			{
-				Polygon->SetColliding(true);
-				Circle->SetColliding(true);
-				CollidingActors.Add(Polygon);
-				CollidingActors.Add(Circle);
+		CollidingActors.Add(A);
+		CollidingActors.Add(B);
 
-				TPair<AActor*, AActor*> Pair = MakeSortedPair(Polygon, Circle);
-				CurrentOverlaps.Add(Pair);
+		TPair<AActor*, AActor*> Pair = MakeSortedPair(A, B);
+		CurrentOverlaps.Add(Pair);
 
-				if (!PreviousOverlaps.Contains(Pair))
-				{
-					Polygon->OnSATOverlapBeginDelegate.Broadcast(Circle);
-					Circle->OnSATOverlapBeginDelegate.Broadcast(Polygon);
-				}
-				
-				if (CircleResponse == ESATCollisionResponse::Block || PolygonResponse == ESATCollisionResponse::Block)
-				{
-					ApplyCirclePolygonMTV(*Circle, *Polygon, Axis, Overlap);
-				}
-			}
+		if (!PreviousOverlaps.Contains(Pair))
+		{
+			VisitShapeActor(A, [B](auto& Shape) { Shape.OnSATOverlapBeginDelegate.Broadcast(B); });
+			VisitShapeActor(B, [A](auto& Shape) { Shape.OnSATOverlapBeginDelegate.Broadcast(A); });
 		}
 	}
 
@@ -191,169 +1200,265 @@ void USATCollisionSubsystem::Tick(float DeltaTime)
 
 			if (IsValid(A))
 			{
-				if (auto Poly = Cast<APolygon2D>(A))
-				{
-					Poly->OnSATOverlapBeginDelegate.Broadcast(B);
-				}
-				else if (auto Circle = Cast<ACircle2D>(A))
-				{
-					Circle->OnSATOverlapBeginDelegate.Broadcast(B);
-				}
+				VisitShapeActor(A, [B](auto& Shape) { Shape.OnSATOverlapEndDelegate.Broadcast(B); });
 			}
 
 			if (IsValid(B))
 			{
-				if (auto Poly = Cast<APolygon2D>(B))
-				{
-					Poly->OnSATOverlapEndDelegate.Broadcast(A);
-				}
-				else if (auto Circle = Cast<ACircle2D>(B))
-				{
-					Circle->OnSATOverlapEndDelegate.Broadcast(A);
-				}
+				VisitShapeActor(B, [A](auto& Shape) { Shape.OnSATOverlapEndDelegate.Broadcast(A); });
 			}
 		}
 	}
 	
 	PreviousOverlaps = CurrentOverlaps;
-	
-	for (TWeakObjectPtr<APolygon2D> PolyActor : PolygonActors)
+
+	for (AActor* Actor : FrameActors)
 	{
-		APolygon2D* Polygon = PolyActor.Get();
-		if (IsValid(Polygon) && !CollidingActors.Contains(Polygon))
-		{
-			Polygon->SetColliding(false);
-		}
+		if (!Actor) continue;
+
+		const bool bColliding = CollidingActors.Contains(Actor);
+		VisitShapeActor(Actor, [bColliding](auto& Shape) { Shape.SetColliding(bColliding); });
 	}
 
-	for (TWeakObjectPtr<ACircle2D> CircleActor : CircleActors)
+	if (Recorder.IsRecording())
 	{
-		ACircle2D* Circle = CircleActor.Get();
-		if (IsValid(Circle) && !CollidingActors.Contains(Circle))
-		{
-			Circle->SetColliding(false);
-		}
+		Frame.BuildEvents(RecordedOverlapIds);
+		Recorder.WriteFrame(Frame);
 	}
 }
 
-bool USATCollisionSubsystem::CheckSATCollision(const APolygon2D& A, const FTransform& TransformA, const APolygon2D& B,
-	const FTransform& TransformB, FVector2D& OutAxis, float& OutOverlap)
+bool USATCollisionSubsystem::CheckSATCollision(const FSATShapeState& A, const FSATShapeState& B,
+	bool bGenerateContactPoints, FSATContact& OutContact)
 {
-	float MinA, MaxA, MinB, MaxB;
-	float SmallestOverlap = TNumericLimits<float>::Max();
-	bool bIsColliding = false;
+	int32 EdgeA;
+	const FSATReal SeparationA = FindMaxSeparation(A, B, EdgeA);
+	if (SeparationA > 0.f) return false;
+
+	int32 EdgeB;
+	const FSATReal SeparationB = FindMaxSeparation(B, A, EdgeB);
+	if (SeparationB > 0.f) return false;
+
+	// The reference face is the one with the least penetration, biased towards A (by half a
+	// millimetre) so the choice doesn't flicker between frames when both are about equal
+	const bool bFlip = SeparationB > SeparationA + 0.05f;
+	const FSATShapeState& Reference = bFlip ? B : A;
+	const FSATShapeState& Incident = bFlip ? A : B;
+	const int32 ReferenceEdge = bFlip ? EdgeB : EdgeA;
+	const FSATVector2 ReferenceNormal = Reference.WorldNormals[ReferenceEdge];
+
+	OutContact.Axis = FVector2D(bFlip ? -ReferenceNormal : ReferenceNormal);
+	OutContact.Overlap = -FMath::Max(SeparationA, SeparationB);
+	OutContact.NumPoints = 0;
+
+	if (bGenerateContactPoints)
+	{
+		FSATVector2 IncidentSegment[2];
+		FindIncidentSegment(Incident, ReferenceNormal, IncidentSegment);
+		ClipContactPoints(Reference, ReferenceEdge, IncidentSegment, OutContact);
+	}
 
-	const TArray<FVector2D>& PointsA = A.GetTransformedPoints(TransformA);
-	const TArray<FVector2D>& PointsB = B.GetTransformedPoints(TransformB);
+	return true;
+}
 
-	std::vector<FVector2D> Normals;
+bool USATCollisionSubsystem::CheckBoxCollision(const FSATShapeState& A, const FSATShapeState& B,
+	bool bGenerateContactPoints, FSATContact& OutContact)
+{
+	const FSATVector2 Delta = B.WorldCenter - A.WorldCenter;
+	const FSATVector2* AxesA = A.WorldAxes;
+	const FSATVector2* AxesB = B.WorldAxes;
 
-	// Get normals for A
-	for (size_t i = 0; i < PointsA.Num(); ++i)
+	// Rotation of B relative to A, shared by all four projections
+	FSATReal R[2][2];
+	for (int32 i = 0; i < 2; ++i)
 	{
-		FVector2D P1 = PointsA[i];
-		FVector2D P2 = PointsA[(i + 1) % PointsA.Num()];
-		FVector2D Edge = P2 - P1;
-		FVector2D Normal(-Edge.Y, Edge.X);
-		Normals.push_back(Normal.GetSafeNormal());
+		for (int32 j = 0; j < 2; ++j)
+		{
+			R[i][j] = FMath::Abs(FSATVector2::DotProduct(AxesA[i], AxesB[j]));
+		}
 	}
 
-	// Get normals for B
-	for (size_t i = 0; i < PointsB.Num(); ++i)
+	FSATReal BestOverlap = TNumericLimits<FSATReal>::Max();
+	FSATVector2 BestAxis = FSATVector2::ZeroVector;
+	bool bBestOnB = false;
+
+	for (int32 i = 0; i < 2; ++i)
 	{
-		FVector2D P1 = PointsB[i];
-		FVector2D P2 = PointsB[(i + 1) % PointsB.Num()];
-		FVector2D Edge = P2 - P1;
-		FVector2D Normal(-Edge.Y, Edge.X);
-		Normals.push_back(Normal.GetSafeNormal());
+		const FSATReal Distance = FSATVector2::DotProduct(Delta, AxesA[i]);
+		const FSATReal Overlap = A.WorldHalfExtents[i] + B.WorldHalfExtents.X * R[i][0] + B.WorldHalfExtents.Y * R[i][1] - FMath::Abs(Distance);
+		if (Overlap < 0.f) return false;
+
+		if (Overlap < BestOverlap)
+		{
+			BestOverlap = Overlap;
+			BestAxis = Distance < 0.f ? -AxesA[i] : AxesA[i];
+		}
 	}
 
-	// Loop through all normals (separating axes)
-	for (const FVector2D& Axis : Normals)
+	for (int32 j = 0; j < 2; ++j)
 	{
-		// Project both polygons onto the axis
-		ProjectPolygonOntoAxis(PointsA, Axis, MinA, MaxA);
-		ProjectPolygonOntoAxis(PointsB, Axis, MinB, MaxB);
+		const FSATReal Distance = FSATVector2::DotProduct(Delta, AxesB[j]);
+		const FSATReal Overlap = B.WorldHalfExtents[j] + A.WorldHalfExtents.X * R[0][j] + A.WorldHalfExtents.Y * R[1][j] - FMath::Abs(Distance);
+		if (Overlap < 0.f) return false;
 
-		// If projections don't overlap, no collision
-		if (MaxA < MinB || MaxB < MinA)
+		// Same bias towards A's faces as CheckSATCollision
+		if (Overlap + 0.05f < BestOverlap)
 		{
-			return false;
+			BestOverlap = Overlap;
+			BestAxis = Distance < 0.f ? -AxesB[j] : AxesB[j];
+			bBestOnB = true;
 		}
+	}
+
+	OutContact.Axis = FVector2D(BestAxis);
+	OutContact.Overlap = BestOverlap;
+	OutContact.NumPoints = 0;
 
-		// Check for smallest overlap
-		float Overlap = FMath::Min(MaxA, MaxB) - FMath::Max(MinA, MinB);
-		if (Overlap < SmallestOverlap)
+	if (!bGenerateContactPoints) return true;
+
+	// The reference face is the one whose outward normal is the axis (towards the other box)
+	const FSATShapeState& Reference = bBestOnB ? B : A;
+	const FSATShapeState& Incident = bBestOnB ? A : B;
+	const FSATVector2 ReferenceNormal = bBestOnB ? -BestAxis : BestAxis;
+
+	int32 ReferenceEdge = 0;
+	for (int32 i = 1; i < Reference.WorldNormals.Num(); ++i)
+	{
+		if (FSATVector2::DotProduct(Reference.WorldNormals[i], ReferenceNormal) >
+			FSATVector2::DotProduct(Reference.WorldNormals[ReferenceEdge], ReferenceNormal))
 		{
-			SmallestOverlap = Overlap;
-			OutAxis = Axis;
-			OutOverlap = SmallestOverlap;
-			bIsColliding = true;
+			ReferenceEdge = i;
 		}
 	}
-	
-	return bIsColliding;
+
+	FSATVector2 IncidentSegment[2];
+	FindIncidentSegment(Incident, ReferenceNormal, IncidentSegment);
+	ClipContactPoints(Reference, ReferenceEdge, IncidentSegment, OutContact);
+	return true;
 }
 
-FVector2D USATCollisionSubsystem::GetPolygonMTV(const APolygon2D& A, const FTransform& TransformA, const APolygon2D& B,
-	const FTransform& TransformB)
+void USATCollisionSubsystem::FindIncidentSegment(const FSATShapeState& Incident, const FSATVector2& ReferenceNormal,
+	FSATVector2 OutSegment[2])
 {
-	FVector2D Axis;
-	float Overlap = 0;
-
-	if (!CheckSATCollision(A, TransformA, B, TransformB, Axis, Overlap))
+	int32 IncidentEdge = 0;
+	FSATReal MinDot = TNumericLimits<FSATReal>::Max();
+	for (int32 i = 0; i < Incident.WorldNormals.Num(); ++i)
 	{
-		return FVector2D::ZeroVector;
+		const FSATReal Dot = FSATVector2::DotProduct(ReferenceNormal, Incident.WorldNormals[i]);
+		if (Dot < MinDot)
+		{
+			MinDot = Dot;
+			IncidentEdge = i;
+		}
 	}
 
-	Axis.Normalize();
-	FVector2D CentroidA = A.GetCentroidWorld();
-	FVector2D CentroidB = B.GetCentroidWorld();
+	OutSegment[0] = Incident.WorldPoints[IncidentEdge];
+	OutSegment[1] = Incident.WorldPoints[(IncidentEdge + 1) % Incident.WorldPoints.Num()];
+}
+
+void USATCollisionSubsystem::ClipContactPoints(const FSATShapeState& Reference, int32 ReferenceEdge,
+	const FSATVector2 IncidentSegment[2], FSATContact& OutContact)
+{
+	const FSATVector2 ReferenceNormal = Reference.WorldNormals[ReferenceEdge];
+	const int32 NumReference = Reference.WorldPoints.Num();
+	const FSATVector2 V1 = Reference.WorldPoints[ReferenceEdge];
+	const FSATVector2 V2 = Reference.WorldPoints[(ReferenceEdge + 1) % NumReference];
+	const FSATVector2 Tangent = (V2 - V1).GetSafeNormal();
+
+	// Clip the incident edge against the side planes of the reference face
+	FSATVector2 Clipped1[2];
+	FSATVector2 Clipped2[2];
+	if (ClipSegmentToLine(Clipped1, IncidentSegment, -Tangent, -FSATVector2::DotProduct(Tangent, V1)) < 2) return;
+	if (ClipSegmentToLine(Clipped2, Clipped1, Tangent, FSATVector2::DotProduct(Tangent, V2)) < 2) return;
+
+	// Keep the points below the reference face, placed halfway between both surfaces
+	for (const FSATVector2& Point : Clipped2)
+	{
+		const FSATReal Separation = FSATVector2::DotProduct(ReferenceNormal, Point - V1);
+		if (Separation <= 0.f)
+		{
+			FSATContactPoint& ContactPoint = OutContact.Points[OutContact.NumPoints++];
+			ContactPoint.Depth = -Separation;
+			ContactPoint.Position = Reference.ToWorld(Point - 0.5f * Separation * ReferenceNormal);
+		}
+	}
+}
 
-	FVector2D Direction = CentroidA - CentroidB;
+FSATReal USATCollisionSubsystem::FindMaxSeparation(const FSATShapeState& A, const FSATShapeState& B, int32& OutEdge)
+{
+	FSATReal MaxSeparation = -TNumericLimits<FSATReal>::Max();
+	OutEdge = 0;
 
-	if (FVector2D::DotProduct(Axis, Direction) < 0)
+	for (int32 i = 0; i < A.WorldNormals.Num(); ++i)
 	{
-		Axis *= -1;
+		const FSATVector2& Normal = A.WorldNormals[i];
+		if (Normal.IsZero()) continue; // Degenerate edge
+
+		// Deepest point of B behind this edge
+		FSATReal Separation = TNumericLimits<FSATReal>::Max();
+		for (const FSATVector2& Point : B.WorldPoints)
+		{
+			Separation = FMath::Min(Separation, static_cast<FSATReal>(FSATVector2::DotProduct(Normal, Point - A.WorldPoints[i])));
+		}
+
+		if (Separation > MaxSeparation)
+		{
+			MaxSeparation = Separation;
+			OutEdge = i;
+
+			// Separating axis found
+			if (MaxSeparation > 0.f) break;
+		}
 	}
 
-	return Axis * Overlap;
+	return MaxSeparation;
 }
 
-void USATCollisionSubsystem::ApplyPolygonMTV(APolygon2D& A, const FTransform& TransformA, APolygon2D& B,
-	const FTransform& TransformB)
+int32 USATCollisionSubsystem::ClipSegmentToLine(FSATVector2 OutSegment[2], const FSATVector2 InSegment[2],
+	const FSATVector2& Normal, FSATReal Offset)
 {
-	FVector2D MTV = GetPolygonMTV(A, TransformA, B, TransformB);
-	if (MTV.IsNearlyZero()) return;
+	int32 NumOut = 0;
+
+	// Keeps the part of the segment where Dot(Normal, Point) <= Offset
+	const FSATReal Distance0 = FSATVector2::DotProduct(Normal, InSegment[0]) - Offset;
+	const FSATReal Distance1 = FSATVector2::DotProduct(Normal, InSegment[1]) - Offset;
+
+	if (Distance0 <= 0.f) OutSegment[NumOut++] = InSegment[0];
+	if (Distance1 <= 0.f) OutSegment[NumOut++] = InSegment[1];
 
-	FVector2D HalfMTV = 0.5f * MTV;
+	if (Distance0 * Distance1 < 0.f)
+	{
+		const FSATReal Alpha = Distance0 / (Distance0 - Distance1);
+		OutSegment[NumOut++] = InSegment[0] + Alpha * (InSegment[1] - InSegment[0]);
+	}
 
-	A.TranslatePoints(HalfMTV);   // Implement this in APolygon2D to offset Points
-	B.TranslatePoints(-HalfMTV);  // Same as above
+	return NumOut;
 }
 
-bool USATCollisionSubsystem::CheckCircleCollision(const ACircle2D& A, const FTransform& TransformA, const ACircle2D& B,
-                                                  const FTransform& TransformB, FVector2D& OutAxis, float& OutOverlap)
+void USATCollisionSubsystem::ApplySplitMTV(FSATShapeState& A, FSATShapeState& B,
+	const FSATVector2& Axis, FSATReal Overlap)
 {
-	// Get world positions of both circles
-	const FVector WorldPosA = TransformA.TransformPosition(FVector(A.X, A.Y, 0.f));
-	const FVector WorldPosB = TransformB.TransformPosition(FVector(B.X, B.Y, 0.f));
-	const FVector2D CenterA(WorldPosA.X, WorldPosA.Y);
-	const FVector2D CenterB(WorldPosB.X, WorldPosB.Y);
+	FSATVector2 MTV = Axis * Overlap;
+	if (MTV.IsNearlyZero()) return;
+
+	FSATVector2 HalfMTV = 0.5f * MTV;
 
-	const float RadiusA = A.Radius;
-	const float RadiusB = B.Radius;
+	A.Translate(-HalfMTV);
+	B.Translate(HalfMTV);
+}
 
-	const FVector2D Delta = CenterB - CenterA;
-	const float DistanceSq = Delta.SizeSquared();
-	const float RadiusSum = RadiusA + RadiusB;
+bool USATCollisionSubsystem::CheckCircleCollision(const FSATVector2& CenterA, FSATReal RadiusA, const FSATVector2& CenterB,
+                                                  FSATReal RadiusB, FSATVector2& OutAxis, FSATReal& OutOverlap)
+{
+	const FSATVector2 Delta = CenterB - CenterA;
+	const FSATReal DistanceSq = Delta.SizeSquared();
+	const FSATReal RadiusSum = RadiusA + RadiusB;
 
 	if (DistanceSq > RadiusSum * RadiusSum)
 	{
 		return false; // Not colliding
 	}
 
-	const float Distance = FMath::Sqrt(DistanceSq);
+	const FSATReal Distance = FMath::Sqrt(DistanceSq);
 
 	// Avoid division by zero if circles are exactly overlapping
 	if (Distance > KINDA_SMALL_NUMBER)
@@ -364,120 +1469,434 @@ bool USATCollisionSubsystem::CheckCircleCollision(const ACircle2D& A, const FTra
 	else
 	{
 		// Circles are perfectly overlapping; choose an arbitrary MTV
-		OutAxis = FVector2D(1, 0);
+		OutAxis = FSATVector2(1, 0);
 		OutOverlap = RadiusSum;
 	}
 
 	return true;
 }
 
-void USATCollisionSubsystem::ApplyCircleCircleMTV(ACircle2D& A, ACircle2D& B, const FVector2D& Axis, float Overlap)
+void USATCollisionSubsystem::ApplyCircleCircleMTV(FSATShapeState& A, FSATShapeState& B, const FSATVector2& Axis, FSATReal Overlap)
 {
 	if (FMath::IsNearlyZero(Overlap)) return;
 
-	FVector2D NormalizedAxis = Axis.GetSafeNormal();
+	FSATVector2 NormalizedAxis = Axis.GetSafeNormal();
 	if (NormalizedAxis.IsNearlyZero()) return;
 
-	FVector2D MTV = NormalizedAxis * Overlap;
+	FSATVector2 MTV = NormalizedAxis * Overlap;
 
 	// Split movement evenly between both circles
-	const FVector2D HalfMTV = 0.5f * MTV;
+	const FSATVector2 HalfMTV = 0.5f * MTV;
 
-	A.AddActorWorldOffset(FVector(-HalfMTV, 0.0f));
-	B.AddActorWorldOffset(FVector(HalfMTV, 0.0f));
+	A.Translate(-HalfMTV);
+	B.Translate(HalfMTV);
 }
 
-void USATCollisionSubsystem::ApplyCirclePolygonMTV(ACircle2D& Circle, APolygon2D& Polygon, const FVector2D& Axis,
-                                                   float Overlap)
+bool USATCollisionSubsystem::CheckCirclePolygonCollision(const FSATShapeState& Circle, const FSATShapeState& Polygon,
+                                                         FSATVector2& OutAxis, FSATReal& OutOverlap)
 {
-	if (FMath::IsNearlyZero(Overlap)) return;
+	const FSATVector2& Center = Circle.WorldCenter;
+	const FSATReal Radius = Circle.Radius;
+	const TArray<FSATVector2>& Points = Polygon.WorldPoints;
+	const TArray<FSATVector2>& Normals = Polygon.WorldNormals;
+
+	// Edge the center is furthest in front of
+	int32 EdgeIndex = INDEX_NONE;
+	FSATReal Separation = -TNumericLimits<FSATReal>::Max();
+	for (int32 i = 0; i < Points.Num(); ++i)
+	{
+		if (Normals[i].IsZero()) continue; // Degenerate edge
 
-	FVector2D NormalizedAxis = Axis.GetSafeNormal();
-	if (NormalizedAxis.IsNearlyZero()) return;
+		const FSATReal EdgeSeparation = FSATVector2::DotProduct(Normals[i], Center - Points[i]);
+		if (EdgeSeparation > Radius)
+		{
+			return false; // Separating axis found
+		}
+
+		if (EdgeSeparation > Separation)
+		{
+			Separation = EdgeSeparation;
+			EdgeIndex = i;
+		}
+	}
+
+	if (EdgeIndex == INDEX_NONE) return false;
+
+	const FSATVector2& Normal = Normals[EdgeIndex];
+
+	// Center is inside the polygon, push out through the closest face
+	if (Separation < KINDA_SMALL_NUMBER)
+	{
+		OutAxis = Normal;
+		OutOverlap = Radius - Separation;
+		return true;
+	}
+
+	// Otherwise the closest feature is this edge or one of its vertices, depending on
+	// which Voronoi region of the edge the center falls in
+	const FSATVector2& V1 = Points[EdgeIndex];
+	const FSATVector2& V2 = Points[(EdgeIndex + 1) % Points.Num()];
+
+	auto CheckVertex = [&](const FSATVector2& Vertex)
+	{
+		const FSATVector2 Delta = Center - Vertex;
+		const FSATReal DistanceSq = Delta.SizeSquared();
+		if (DistanceSq > Radius * Radius) return false;
 
-	FVector2D MTV = NormalizedAxis * Overlap;
+		const FSATReal Distance = FMath::Sqrt(DistanceSq);
+		OutAxis = Delta / Distance;
+		OutOverlap = Radius - Distance;
+		return true;
+	};
+
+	if (FSATVector2::DotProduct(Center - V1, V2 - V1) <= 0.f)
+	{
+		return CheckVertex(V1);
+	}
+
+	if (FSATVector2::DotProduct(Center - V2, V1 - V2) <= 0.f)
+	{
+		return CheckVertex(V2);
+	}
+
+	OutAxis = Normal;
+	OutOverlap = Radius - Separation;
+	return true;
+}
+
+bool USATCollisionSubsystem::CheckCircleBoxCollision(const FSATShapeState& Circle, const FSATShapeState& Box,
+                                                     FSATVector2& OutAxis, FSATReal& OutOverlap)
+{
+	const FSATVector2& AxisX = Box.WorldAxes[0];
+	const FSATVector2& AxisY = Box.WorldAxes[1];
+	const FSATVector2 Delta = Circle.WorldCenter - Box.WorldCenter;
+	const FSATVector2 Local(FSATVector2::DotProduct(Delta, AxisX), FSATVector2::DotProduct(Delta, AxisY));
+	const FSATVector2& Extents = Box.WorldHalfExtents;
+
+	const FSATVector2 Closest = Box.WorldCenter
+		+ AxisX * FMath::Clamp(Local.X, -Extents.X, Extents.X)
+		+ AxisY * FMath::Clamp(Local.Y, -Extents.Y, Extents.Y);
+
+	const FSATVector2 ToCenter = Circle.WorldCenter - Closest;
+	const FSATReal DistanceSq = ToCenter.SizeSquared();
+
+	// Center inside the box, or too close to its surface for ToCenter to have a reliable direction.
+	// Push out through the nearest face.
+	if (DistanceSq <= KINDA_SMALL_NUMBER)
+	{
+		const FSATReal DepthX = Extents.X - FMath::Abs(Local.X);
+		const FSATReal DepthY = Extents.Y - FMath::Abs(Local.Y);
+		if (DepthX < DepthY)
+		{
+			OutAxis = Local.X < 0.f ? -AxisX : AxisX;
+			OutOverlap = Circle.Radius + DepthX;
+		}
+		else
+		{
+			OutAxis = Local.Y < 0.f ? -AxisY : AxisY;
+			OutOverlap = Circle.Radius + DepthY;
+		}
+		return true;
+	}
 
-	// Move circle in MTV direction (plus nudge)
-	Circle.AddActorWorldOffset(FVector(MTV + (NormalizedAxis * 0.01f), 0.0f));
+	if (DistanceSq > Circle.Radius * Circle.Radius) return false;
 
-	// Push polygon in opposite direction
-	FVector2D OpposingMTV = -MTV;
-	Polygon.AddActorWorldOffset(FVector(OpposingMTV, 0.0f));
+	const FSATReal Distance = FMath::Sqrt(DistanceSq);
+	OutAxis = ToCenter / Distance;
+	OutOverlap = Circle.Radius - Distance;
+	return true;
 }
 
-bool USATCollisionSubsystem::CheckCirclePolygonCollision(const ACircle2D& Circle, const FTransform& TransformCircle,
-                                                         const APolygon2D& Polygon, const FTransform& TransformPolygon, FVector2D& OutAxis, float& OutOverlap)
+bool USATCollisionSubsystem::CheckCapsulePolygonCollision(const FSATShapeState& Capsule, const FSATShapeState& Polygon,
+                                                          FSATVector2& OutAxis, FSATReal& OutOverlap, int32& OutEdge)
 {
-	const FVector WorldCenter = TransformCircle.TransformPosition(FVector(Circle.X, Circle.Y, 0.f));
-	const FVector2D CircleCenter(WorldCenter.X, WorldCenter.Y);
-	const float Radius = Circle.Radius;
+	const FSATVector2& Start = Capsule.WorldPoints[0];
+	const FSATVector2& End = Capsule.WorldPoints[1];
+
+	OutOverlap = TNumericLimits<FSATReal>::Max();
+	OutEdge = INDEX_NONE;
+
+	// Returns false once the axis separates the shapes, otherwise keeps the shallowest one
+	auto TestAxis = [&](const FSATVector2& Axis, int32 Edge)
+	{
+		FSATReal PolygonMin, PolygonMax;
+		ProjectOntoAxis(Polygon.WorldPoints, Axis, PolygonMin, PolygonMax);
+
+		const FSATReal ProjStart = FSATVector2::DotProduct(Start, Axis);
+		const FSATReal ProjEnd = FSATVector2::DotProduct(End, Axis);
+		const FSATReal CapsuleMin = FMath::Min(ProjStart, ProjEnd) - Capsule.Radius;
+		const FSATReal CapsuleMax = FMath::Max(ProjStart, ProjEnd) + Capsule.Radius;
+
+		// Pushing the capsule along +Axis or -Axis, whichever is shorter
+		const FSATReal OverlapPositive = PolygonMax - CapsuleMin;
+		const FSATReal OverlapNegative = CapsuleMax - PolygonMin;
+		const FSATReal Overlap = FMath::Min(OverlapPositive, OverlapNegative);
+		if (Overlap < 0.f) return false;
+
+		if (Overlap < OutOverlap)
+		{
+			OutOverlap = Overlap;
+			OutAxis = OverlapPositive <= OverlapNegative ? Axis : -Axis;
+			OutEdge = Edge;
+		}
+		return true;
+	};
+
+	// Opposite box faces share an axis, so a box only needs two of its four normals
+	const int32 NumFaceAxes = Polygon.Type == ESATShapeType::Box ? 2 : Polygon.WorldNormals.Num();
+	for (int32 i = 0; i < NumFaceAxes; ++i)
+	{
+		if (Polygon.WorldNormals[i].IsZero()) continue; // Degenerate edge
+		if (!TestAxis(Polygon.WorldNormals[i], i)) return false;
+	}
+
+	const FSATVector2 Direction = (End - Start).GetSafeNormal();
+	if (!Direction.IsZero() && !TestAxis(FSATVector2(-Direction.Y, Direction.X), INDEX_NONE)) return false;
 
-	const TArray<FVector2D> PolygonPoints = Polygon.GetTransformedPoints(TransformPolygon);
-	const TArray<FVector2D> Normals = Polygon.GetNormalsTransformed(TransformPolygon);
+	// Cap axes: each segment end against its closest polygon vertex
+	for (const FSATVector2& Tip : Capsule.WorldPoints)
+	{
+		const FSATVector2* ClosestVertex = nullptr;
+		FSATReal ClosestDistanceSq = TNumericLimits<FSATReal>::Max();
+		for (const FSATVector2& Vertex : Polygon.WorldPoints)
+		{
+			const FSATReal DistanceSq = FSATVector2::DistSquared(Tip, Vertex);
+			if (DistanceSq < ClosestDistanceSq)
+			{
+				ClosestDistanceSq = DistanceSq;
+				ClosestVertex = &Vertex;
+			}
+		}
+
+		const FSATVector2 Axis = (Tip - *ClosestVertex).GetSafeNormal();
+		if (!Axis.IsZero() && !TestAxis(Axis, INDEX_NONE)) return false;
+	}
+
+	// Pushed out through the side opposite the face, which only a box is guaranteed to have as a face
+	if (OutEdge != INDEX_NONE && FSATVector2::DotProduct(OutAxis, Polygon.WorldNormals[OutEdge]) < 0.f)
+	{
+		OutEdge = Polygon.Type == ESATShapeType::Box ? (OutEdge + 2) % 4 : INDEX_NONE;
+	}
+
+	return true;
+}
 
-	TArray<FVector2D> Axes = Normals;
+void USATCollisionSubsystem::AddCapsulePolygonContactPoints(const FSATShapeState& Capsule, const FSATShapeState& Polygon,
+                                                            int32 Edge, const FSATVector2& Axis, FSATContact& OutContact)
+{
+	const FSATVector2 Offset = Axis * Capsule.Radius;
 
-	// Find closest polygon vertex to the circle center
-	FVector2D ClosestVertex;
-	float MinDistSq = TNumericLimits<float>::Max();
-	for (const FVector2D& Point : PolygonPoints)
+	if (Edge != INDEX_NONE)
+	{
+		// Against a face, the side of the capsule clips like a polygon edge
+		const FSATVector2 IncidentSegment[2] = { Capsule.WorldPoints[0] - Offset, Capsule.WorldPoints[1] - Offset };
+		ClipContactPoints(Polygon, Edge, IncidentSegment, OutContact);
+		if (OutContact.NumPoints > 0) return;
+	}
+	else
 	{
-		const float DistSq = FVector2D::DistSquared(CircleCenter, Point);
-		if (DistSq < MinDistSq)
+		// The axis is the capsule's own, so usually a polygon vertex reaches into the capsule: the deepest
+		// along the axis among those within its radius or pushed through its segment. The deepest overall
+		// may lie past the capsule's ends.
+		const FSATVector2& Start = Capsule.WorldPoints[0];
+		const FSATVector2 Segment = Capsule.WorldPoints[1] - Start;
+		const FSATReal LengthSq = Segment.SizeSquared();
+
+		const FSATVector2* Deepest = nullptr;
+		for (const FSATVector2& Vertex : Polygon.WorldPoints)
+		{
+			const FSATReal T = LengthSq > 0.f ? FSATVector2::DotProduct(Vertex - Start, Segment) / LengthSq : -1.f;
+			const FSATVector2 Closest = ClosestPointOnSegment(Vertex, Start, Capsule.WorldPoints[1]);
+			const bool bThroughSegment = T >= 0.f && T <= 1.f && FSATVector2::DotProduct(Vertex - Closest, Axis) > 0.f;
+			if (!bThroughSegment && FSATVector2::DistSquared(Vertex, Closest) > Capsule.Radius * Capsule.Radius) continue;
+
+			if (!Deepest || FSATVector2::DotProduct(Vertex, Axis) > FSATVector2::DotProduct(*Deepest, Axis))
+			{
+				Deepest = &Vertex;
+			}
+		}
+
+		if (Deepest)
 		{
-			MinDistSq = DistSq;
-			ClosestVertex = Point;
+			OutContact.NumPoints = 1;
+			OutContact.Points[0].Position = Polygon.ToWorld(*Deepest - Axis * (0.5f * OutContact.Overlap));
+			OutContact.Points[0].Depth = OutContact.Overlap;
+			return;
 		}
 	}
 
-	// Add axis from circle center to closest vertex
-	FVector2D CircleAxis = ClosestVertex - CircleCenter;
-	if (!CircleAxis.IsNearlyZero())
+	// Otherwise a single point on the cap reaching deepest into the polygon
+	const FSATVector2& Start = Capsule.WorldPoints[0];
+	const FSATVector2& End = Capsule.WorldPoints[1];
+	const FSATVector2& Tip = FSATVector2::DotProduct(Start, Axis) <= FSATVector2::DotProduct(End, Axis) ? Start : End;
+
+	OutContact.NumPoints = 1;
+	OutContact.Points[0].Position = Capsule.ToWorld(Tip - Offset + Axis * (0.5f * OutContact.Overlap));
+	OutContact.Points[0].Depth = OutContact.Overlap;
+}
+
+bool USATCollisionSubsystem::CheckCapsuleCollision(const FSATShapeState& A, const FSATShapeState& B,
+                                                   FSATVector2& OutAxis, FSATReal& OutOverlap, FSATVector2& OutPointA)
+{
+	FSATVector2 PointB;
+	ClosestPointsBetweenSegments(A.WorldPoints[0], A.WorldPoints[1], B.WorldPoints[0], B.WorldPoints[1], OutPointA, PointB);
+
+	const FSATReal RadiusSum = A.Radius + B.Radius;
+	const FSATVector2 Delta = PointB - OutPointA;
+	const FSATReal DistanceSq = Delta.SizeSquared();
+	if (DistanceSq > RadiusSum * RadiusSum) return false;
+
+	if (DistanceSq > KINDA_SMALL_NUMBER)
 	{
-		Axes.Add(CircleAxis.GetSafeNormal());
+		const FSATReal Distance = FMath::Sqrt(DistanceSq);
+		OutAxis = Delta / Distance;
+		OutOverlap = RadiusSum - Distance;
+		return true;
 	}
 
-	bool bIsColliding = false;
-	float SmallestOverlap = TNumericLimits<float>::Max();
+	// The segments cross, so the closest points give no direction. Separate along whichever
+	// segment normal needs the shorter push instead, pointing towards B.
+	OutOverlap = TNumericLimits<FSATReal>::Max();
+	const FSATVector2 CenterDelta = B.WorldCenter - A.WorldCenter;
+
+	for (const FSATShapeState* Shape : { &A, &B })
+	{
+		const FSATVector2 Direction = (Shape->WorldPoints[1] - Shape->WorldPoints[0]).GetSafeNormal();
+		if (Direction.IsZero()) continue;
+
+		FSATVector2 Normal(-Direction.Y, Direction.X);
+		if (FSATVector2::DotProduct(Normal, CenterDelta) < 0.f) Normal = -Normal;
+
+		const FSATReal MaxA = FMath::Max(FSATVector2::DotProduct(A.WorldPoints[0], Normal), FSATVector2::DotProduct(A.WorldPoints[1], Normal)) + A.Radius;
+		const FSATReal MinB = FMath::Min(FSATVector2::DotProduct(B.WorldPoints[0], Normal), FSATVector2::DotProduct(B.WorldPoints[1], Normal)) - B.Radius;
+		if (MaxA - MinB < OutOverlap)
+		{
+			OutOverlap = MaxA - MinB;
+			OutAxis = Normal;
+		}
+	}
 
-	for (const FVector2D& Axis : Axes)
+	// Both segments are points sitting on top of each other
+	if (OutOverlap == TNumericLimits<FSATReal>::Max())
 	{
-		float MinA, MaxA, MinB, MaxB;
+		OutAxis = FSATVector2(1, 0);
+		OutOverlap = RadiusSum;
+	}
 
-		// Project polygon onto axis
-		ProjectPolygonOntoAxis(PolygonPoints, Axis, MinA, MaxA);
+	return true;
+}
 
-		// Project circle onto axis (circle projects to a range centered at dot product)
-		const float CircleCenterProj = FVector2D::DotProduct(CircleCenter, Axis);
-		MinB = CircleCenterProj - Radius;
-		MaxB = CircleCenterProj + Radius;
+bool USATCollisionSubsystem::HasSeparatingFace(const FSATShapeState& A, const FSATShapeState& B)
+{
+	for (int32 i = 0; i < A.WorldNormals.Num(); ++i)
+	{
+		const FSATVector2& Normal = A.WorldNormals[i];
+		if (Normal.IsZero()) continue; // Degenerate edge
 
-		// Check for separation
-		if (MaxA < MinB || MaxB < MinA)
+		// The face separates the shapes if every point of B is in front of it
+		bool bSeparating = true;
+		for (const FSATVector2& Point : B.WorldPoints)
 		{
-			return false; // Separating axis found
+			if (FSATVector2::DotProduct(Normal, Point - A.WorldPoints[i]) <= 0)
+			{
+				bSeparating = false;
+				break;
+			}
 		}
 
-		// Calculate overlap
-		const float Overlap = FMath::Min(MaxA, MaxB) - FMath::Max(MinA, MinB);
-		if (Overlap < SmallestOverlap)
+		if (bSeparating) return true;
+	}
+
+	return false;
+}
+
+bool USATCollisionSubsystem::TestCirclePolygonOverlap(const FSATShapeState& Circle, const FSATShapeState& Polygon)
+{
+	const FSATVector2& Center = Circle.WorldCenter;
+	const FSATReal Radius = Circle.Radius;
+	const TArray<FSATVector2>& Points = Polygon.WorldPoints;
+	const TArray<FSATVector2>& Normals = Polygon.WorldNormals;
+
+	// Same closest feature search as CheckCirclePolygonCollision, on squared distances
+	int32 EdgeIndex = INDEX_NONE;
+	FSATReal Separation = -TNumericLimits<FSATReal>::Max();
+	for (int32 i = 0; i < Points.Num(); ++i)
+	{
+		if (Normals[i].IsZero()) continue; // Degenerate edge
+
+		const FSATReal EdgeSeparation = FSATVector2::DotProduct(Normals[i], Center - Points[i]);
+		if (EdgeSeparation > Radius) return false;
+
+		if (EdgeSeparation > Separation)
 		{
-			SmallestOverlap = Overlap;
-			OutAxis = Axis;
-			OutOverlap = Overlap;
-			bIsColliding = true;
+			Separation = EdgeSeparation;
+			EdgeIndex = i;
 		}
 	}
 
-	// Ensure Minimum Translation Vector points outward from circle
-	if (bIsColliding)
+	if (EdgeIndex == INDEX_NONE) return false;
+	if (Separation < KINDA_SMALL_NUMBER) return true;
+
+	const FSATVector2& V1 = Points[EdgeIndex];
+	const FSATVector2& V2 = Points[(EdgeIndex + 1) % Points.Num()];
+
+	if (FSATVector2::DotProduct(Center - V1, V2 - V1) <= 0.f)
+	{
+		return FSATVector2::DistSquared(Center, V1) <= Radius * Radius;
+	}
+
+	if (FSATVector2::DotProduct(Center - V2, V1 - V2) <= 0.f)
+	{
+		return FSATVector2::DistSquared(Center, V2) <= Radius * Radius;
+	}
+
+	return true;
+}
+
+bool USATCollisionSubsystem::TestCapsulePolygonOverlap(const FSATShapeState& Capsule, const FSATShapeState& Polygon)
+{
+	const FSATVector2& Start = Capsule.WorldPoints[0];
+	const FSATVector2& End = Capsule.WorldPoints[1];
+
+	// Same axes as CheckCapsulePolygonCollision
+	auto Separates = [&](const FSATVector2& Axis)
+	{
+		FSATReal PolygonMin, PolygonMax;
+		ProjectOntoAxis(Polygon.WorldPoints, Axis, PolygonMin, PolygonMax);
+
+		const FSATReal ProjStart = FSATVector2::DotProduct(Start, Axis);
+		const FSATReal ProjEnd = FSATVector2::DotProduct(End, Axis);
+		return FMath::Min(ProjStart, ProjEnd) - Capsule.Radius > PolygonMax
+			|| FMath::Max(ProjStart, ProjEnd) + Capsule.Radius < PolygonMin;
+	};
+
+	const int32 NumFaceAxes = Polygon.Type == ESATShapeType::Box ? 2 : Polygon.WorldNormals.Num();
+	for (int32 i = 0; i < NumFaceAxes; ++i)
 	{
-		const FVector2D Dir = CircleCenter - ClosestVertex;
-		if (FVector2D::DotProduct(OutAxis, Dir) < 0)
+		if (Polygon.WorldNormals[i].IsZero()) continue; // Degenerate edge
+		if (Separates(Polygon.WorldNormals[i])) return false;
+	}
+
+	const FSATVector2 Direction = (End - Start).GetSafeNormal();
+	if (!Direction.IsZero() && Separates(FSATVector2(-Direction.Y, Direction.X))) return false;
+
+	for (const FSATVector2& Tip : Capsule.WorldPoints)
+	{
+		const FSATVector2* ClosestVertex = nullptr;
+		FSATReal ClosestDistanceSq = TNumericLimits<FSATReal>::Max();
+		for (const FSATVector2& Vertex : Polygon.WorldPoints)
 		{
-			OutAxis *= -1;
+			const FSATReal DistanceSq = FSATVector2::DistSquared(Tip, Vertex);
+			if (DistanceSq < ClosestDistanceSq)
+			{
+				ClosestDistanceSq = DistanceSq;
+				ClosestVertex = &Vertex;
+			}
 		}
+
+		const FSATVector2 Axis = (Tip - *ClosestVertex).GetSafeNormal();
+		if (!Axis.IsZero() && Separates(Axis)) return false;
 	}
 
-	return bIsColliding;
+	return true;
 }
@@ -2,17 +2,21 @@
 
 #include "SATCollisions.h"
 
+#include "SATDetectionBatch.h"
+
 #define LOCTEXT_NAMESPACE "FSATCollisionsModule"
 
 void FSATCollisionsModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	FSATDetectionBatch::Get().Startup();
 }
 
 void FSATCollisionsModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FSATDetectionBatch::Get().Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,93 @@
+#include "SATDetectionBatch.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/CoreDelegates.h"
+#include "SATCollisionSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Worlds per Batch"), STAT_SATBatchWorlds, STATGROUP_SATCollision);
+
+FSATDetectionBatch& FSATDetectionBatch::Get()
+{
+	static FSATDetectionBatch Batch;
+	return Batch;
+}
+
+void FSATDetectionBatch::Startup()
+{
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSATDetectionBatch::Flush);
+}
+
+void FSATDetectionBatch::Shutdown()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+}
+
+void FSATDetectionBatch::Enqueue(FSATDetectionJob& Job)
+{
+	check(IsInGameThread() && !HasResultsToApply(Job));
+
+	Job.bQueued = true;
+	Queued.Add(&Job);
+}
+
+void FSATDetectionBatch::Wait(FSATDetectionJob& Job)
+{
+	check(IsInGameThread());
+
+	if (Job.bQueued)
+	{
+		Queued.RemoveSingle(&Job);
+		Job.bQueued = false;
+		Run(Job);
+	}
+	else if (Job.Task.IsValid())
+	{
+		Job.Task.Wait();
+		Job.Task = UE::Tasks::FTask();
+	}
+}
+
+void FSATDetectionBatch::Cancel(FSATDetectionJob& Job)
+{
+	check(IsInGameThread());
+
+	if (Job.bQueued)
+	{
+		Queued.RemoveSingle(&Job);
+		Job.bQueued = false;
+	}
+	else
+	{
+		Wait(Job);
+	}
+}
+
+void FSATDetectionBatch::Flush()
+{
+	SET_DWORD_STAT(STAT_SATBatchWorlds, Queued.Num());
+	if (Queued.Num() == 0) return;
+
+	// Longest first, so a heavy world doesn't start last and hold up the whole batch
+	Queued.Sort([](const FSATDetectionJob& A, const FSATDetectionJob& B) { return A.DetectSeconds > B.DetectSeconds; });
+
+	const UE::Tasks::FTask Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Jobs = Queued]()
+	{
+		ParallelFor(Jobs.Num(), [&Jobs](int32 Index) { Run(*Jobs[Index]); });
+	});
+
+	for (FSATDetectionJob* Job : Queued)
+	{
+		Job->bQueued = false;
+		Job->Task = Task;
+	}
+	Queued.Reset();
+}
+
+void FSATDetectionBatch::Run(FSATDetectionJob& Job)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	USATCollisionSubsystem::DetectCollisions(Job.Frame, Job.BroadPhase);
+	Job.DetectSeconds = FPlatformTime::Seconds() - StartTime;
+	Job.bResultsReady = true;
+}
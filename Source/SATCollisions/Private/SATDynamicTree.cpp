@@ -0,0 +1,316 @@
+#include "SATDynamicTree.h"
+
+namespace
+{
+	FBox2D Union(const FBox2D& A, const FBox2D& B)
+	{
+		return FBox2D(A.Min.ComponentMin(B.Min), A.Max.ComponentMax(B.Max));
+	}
+
+	// 2D stand-in for surface area
+	double Perimeter(const FBox2D& Box)
+	{
+		const FVector2D Size = Box.Max - Box.Min;
+		return 2.0 * (Size.X + Size.Y);
+	}
+
+	bool Contains(const FBox2D& Outer, const FBox2D& Inner)
+	{
+		return Outer.Min.X <= Inner.Min.X && Outer.Min.Y <= Inner.Min.Y
+			&& Inner.Max.X <= Outer.Max.X && Inner.Max.Y <= Outer.Max.Y;
+	}
+
+	FBox2D Expand(const FBox2D& Box, float Amount)
+	{
+		return FBox2D(Box.Min - FVector2D(Amount), Box.Max + FVector2D(Amount));
+	}
+}
+
+int32 FSATDynamicTree::CreateProxy(const FBox2D& Bounds, uint32 UserData)
+{
+	const int32 ProxyId = AllocateNode();
+	Nodes[ProxyId].Bounds = Expand(Bounds, Margin);
+	Nodes[ProxyId].UserData = UserData;
+
+	InsertLeaf(ProxyId);
+	return ProxyId;
+}
+
+void FSATDynamicTree::DestroyProxy(int32 ProxyId)
+{
+	check(Nodes.IsValidIndex(ProxyId) && Nodes[ProxyId].IsLeaf());
+
+	RemoveLeaf(ProxyId);
+	FreeNode(ProxyId);
+}
+
+bool FSATDynamicTree::MoveProxy(int32 ProxyId, const FBox2D& Bounds)
+{
+	check(Nodes.IsValidIndex(ProxyId) && Nodes[ProxyId].IsLeaf());
+
+	const FBox2D& FatBounds = Nodes[ProxyId].Bounds;
+	if (Contains(FatBounds, Bounds))
+	{
+		// Still inside its fat box. Only re-insert if the box has become far too large for the
+		// shape, e.g. after it shrank, since that would only produce useless pairs.
+		if (Contains(Expand(Bounds, 4.f * Margin), FatBounds))
+		{
+			return false;
+		}
+	}
+
+	RemoveLeaf(ProxyId);
+	Nodes[ProxyId].Bounds = Expand(Bounds, Margin);
+	InsertLeaf(ProxyId);
+	return true;
+}
+
+int32 FSATDynamicTree::AllocateNode()
+{
+	if (FreeList == INDEX_NONE)
+	{
+		return Nodes.AddDefaulted();
+	}
+
+	const int32 NodeId = FreeList;
+	FreeList = Nodes[NodeId].Parent;
+	Nodes[NodeId] = FNode();
+	return NodeId;
+}
+
+void FSATDynamicTree::FreeNode(int32 NodeId)
+{
+	Nodes[NodeId].Parent = FreeList;
+	Nodes[NodeId].Height = -1;
+	FreeList = NodeId;
+}
+
+void FSATDynamicTree::InsertLeaf(int32 Leaf)
+{
+	if (Root == INDEX_NONE)
+	{
+		Root = Leaf;
+		Nodes[Root].Parent = INDEX_NONE;
+		return;
+	}
+
+	// Find the cheapest sibling for the new leaf
+	const FBox2D LeafBounds = Nodes[Leaf].Bounds;
+	int32 Index = Root;
+	while (!Nodes[Index].IsLeaf())
+	{
+		const FNode& Node = Nodes[Index];
+
+		const double Area = Perimeter(Node.Bounds);
+		const double CombinedArea = Perimeter(Union(Node.Bounds, LeafBounds));
+
+		// Cost of making a new parent for this node and the leaf
+		const double Cost = 2.0 * CombinedArea;
+
+		// Minimum cost of pushing the leaf further down, paid by every ancestor that grows
+		const double InheritanceCost = 2.0 * (CombinedArea - Area);
+
+		auto DescendCost = [&](int32 Child)
+		{
+			const FNode& ChildNode = Nodes[Child];
+			const double NewArea = Perimeter(Union(LeafBounds, ChildNode.Bounds));
+			return ChildNode.IsLeaf()
+				? NewArea + InheritanceCost
+				: NewArea - Perimeter(ChildNode.Bounds) + InheritanceCost;
+		};
+
+		const double Cost1 = DescendCost(Node.Child1);
+		const double Cost2 = DescendCost(Node.Child2);
+
+		if (Cost < Cost1 && Cost < Cost2) break;
+
+		Index = Cost1 < Cost2 ? Node.Child1 : Node.Child2;
+	}
+
+	const int32 Sibling = Index;
+	const int32 OldParent = Nodes[Sibling].Parent;
+	const int32 NewParent = AllocateNode();
+
+	Nodes[NewParent].Parent = OldParent;
+	Nodes[NewParent].Bounds = Union(LeafBounds, Nodes[Sibling].Bounds);
+	Nodes[NewParent].Height = Nodes[Sibling].Height + 1;
+	Nodes[NewParent].Child1 = Sibling;
+	Nodes[NewParent].Child2 = Leaf;
+	Nodes[Sibling].Parent = NewParent;
+	Nodes[Leaf].Parent = NewParent;
+
+	if (OldParent == INDEX_NONE)
+	{
+		Root = NewParent;
+	}
+	else if (Nodes[OldParent].Child1 == Sibling)
+	{
+		Nodes[OldParent].Child1 = NewParent;
+	}
+	else
+	{
+		Nodes[OldParent].Child2 = NewParent;
+	}
+
+	RefitAncestors(Nodes[Leaf].Parent);
+}
+
+void FSATDynamicTree::RemoveLeaf(int32 Leaf)
+{
+	if (Leaf == Root)
+	{
+		Root = INDEX_NONE;
+		return;
+	}
+
+	const int32 Parent = Nodes[Leaf].Parent;
+	const int32 GrandParent = Nodes[Parent].Parent;
+	const int32 Sibling = Nodes[Parent].Child1 == Leaf ? Nodes[Parent].Child2 : Nodes[Parent].Child1;
+
+	FreeNode(Parent);
+
+	if (GrandParent == INDEX_NONE)
+	{
+		Root = Sibling;
+		Nodes[Sibling].Parent = INDEX_NONE;
+		return;
+	}
+
+	// Connect the sibling straight to the grandparent
+	if (Nodes[GrandParent].Child1 == Parent)
+	{
+		Nodes[GrandParent].Child1 = Sibling;
+	}
+	else
+	{
+		Nodes[GrandParent].Child2 = Sibling;
+	}
+	Nodes[Sibling].Parent = GrandParent;
+
+	RefitAncestors(GrandParent);
+}
+
+void FSATDynamicTree::RefitAncestors(int32 Index)
+{
+	while (Index != INDEX_NONE)
+	{
+		Index = Balance(Index);
+
+		FNode& Node = Nodes[Index];
+		const FNode& Child1 = Nodes[Node.Child1];
+		const FNode& Child2 = Nodes[Node.Child2];
+
+		Node.Height = 1 + FMath::Max(Child1.Height, Child2.Height);
+		Node.Bounds = Union(Child1.Bounds, Child2.Bounds);
+
+		Index = Node.Parent;
+	}
+}
+
+int32 FSATDynamicTree::Balance(int32 IndexA)
+{
+	FNode& A = Nodes[IndexA];
+	if (A.IsLeaf() || A.Height < 2)
+	{
+		return IndexA;
+	}
+
+	const int32 IndexB = A.Child1;
+	const int32 IndexC = A.Child2;
+	FNode& B = Nodes[IndexB];
+	FNode& C = Nodes[IndexC];
+
+	const int32 HeightDifference = C.Height - B.Height;
+
+	auto ReplaceChildOfParent = [this, IndexA](int32 Parent, int32 NewChild)
+	{
+		if (Parent == INDEX_NONE)
+		{
+			Root = NewChild;
+		}
+		else if (Nodes[Parent].Child1 == IndexA)
+		{
+			Nodes[Parent].Child1 = NewChild;
+		}
+		else
+		{
+			Nodes[Parent].Child2 = NewChild;
+		}
+	};
+
+	// Rotate C up
+	if (HeightDifference > 1)
+	{
+		const int32 IndexF = C.Child1;
+		const int32 IndexG = C.Child2;
+		FNode& F = Nodes[IndexF];
+		FNode& G = Nodes[IndexG];
+
+		C.Child1 = IndexA;
+		C.Parent = A.Parent;
+		A.Parent = IndexC;
+		ReplaceChildOfParent(C.Parent, IndexC);
+
+		if (F.Height > G.Height)
+		{
+			C.Child2 = IndexF;
+			A.Child2 = IndexG;
+			G.Parent = IndexA;
+			A.Bounds = Union(B.Bounds, G.Bounds);
+			C.Bounds = Union(A.Bounds, F.Bounds);
+			A.Height = 1 + FMath::Max(B.Height, G.Height);
+			C.Height = 1 + FMath::Max(A.Height, F.Height);
+		}
+		else
+		{
+			C.Child2 = IndexG;
+			A.Child2 = IndexF;
+			F.Parent = IndexA;
+			A.Bounds = Union(B.Bounds, F.Bounds);
+			C.Bounds = Union(A.Bounds, G.Bounds);
+			A.Height = 1 + FMath::Max(B.Height, F.Height);
+			C.Height = 1 + FMath::Max(A.Height, G.Height);
+		}
+
+		return IndexC;
+	}
+
+	// Rotate B up
+	if (HeightDifference < -1)
+	{
+		const int32 IndexD = B.Child1;
+		const int32 IndexE = B.Child2;
+		FNode& D = Nodes[IndexD];
+		FNode& E = Nodes[IndexE];
+
+		B.Child1 = IndexA;
+		B.Parent = A.Parent;
+		A.Parent = IndexB;
+		ReplaceChildOfParent(B.Parent, IndexB);
+
+		if (D.Height > E.Height)
+		{
+			B.Child2 = IndexD;
+			A.Child1 = IndexE;
+			E.Parent = IndexA;
+			A.Bounds = Union(C.Bounds, E.Bounds);
+			B.Bounds = Union(A.Bounds, D.Bounds);
+			A.Height = 1 + FMath::Max(C.Height, E.Height);
+			B.Height = 1 + FMath::Max(A.Height, D.Height);
+		}
+		else
+		{
+			B.Child2 = IndexE;
+			A.Child1 = IndexD;
+			D.Parent = IndexA;
+			A.Bounds = Union(C.Bounds, D.Bounds);
+			B.Bounds = Union(A.Bounds, E.Bounds);
+			A.Height = 1 + FMath::Max(C.Height, D.Height);
+			B.Height = 1 + FMath::Max(A.Height, E.Height);
+		}
+
+		return IndexB;
+	}
+
+	return IndexA;
+}
@@ -0,0 +1,67 @@
+#include "SATHull.h"
+
+namespace
+{
+	constexpr float SATQuantizationSteps = TNumericLimits<uint16>::Max();
+}
+
+TSharedRef<FSATHull> FSATHull::Build(TConstArrayView<FVector2D> InPoints)
+{
+	TSharedRef<FSATHull> Hull = MakeShared<FSATHull>();
+
+	for (const FVector2D& Point : InPoints)
+	{
+		Hull->Bounds += FVector2f(Point);
+	}
+
+	const FVector2f Size = Hull->Bounds.GetSize();
+	Hull->QuantizedPoints.Reserve(InPoints.Num());
+	for (const FVector2D& Point : InPoints)
+	{
+		const FVector2f Offset = FVector2f(Point) - Hull->Bounds.Min;
+
+		FSATQuantizedPoint& Quantized = Hull->QuantizedPoints.AddDefaulted_GetRef();
+		Quantized.X = Size.X > 0.f ? static_cast<uint16>(FMath::RoundToInt(Offset.X / Size.X * SATQuantizationSteps)) : 0;
+		Quantized.Y = Size.Y > 0.f ? static_cast<uint16>(FMath::RoundToInt(Offset.Y / Size.Y * SATQuantizationSteps)) : 0;
+	}
+
+	Hull->Decode();
+	return Hull;
+}
+
+void FSATHull::Decode()
+{
+	const FVector2f Step = Bounds.GetSize() / SATQuantizationSteps;
+
+	Points.Reset(QuantizedPoints.Num());
+	for (const FSATQuantizedPoint& Quantized : QuantizedPoints)
+	{
+		Points.Add(Bounds.Min + FVector2f(Quantized.X * Step.X, Quantized.Y * Step.Y));
+	}
+
+	float SignedArea = 0.f;
+	for (int32 i = 0; i < Points.Num(); ++i)
+	{
+		SignedArea += FVector2f::CrossProduct(Points[i], Points[(i + 1) % Points.Num()]);
+	}
+	const float Winding = SignedArea < 0.f ? -1.f : 1.f;
+
+	Normals.Reset(Points.Num());
+	for (int32 i = 0; i < Points.Num(); ++i)
+	{
+		const FVector2f Edge = Points[(i + 1) % Points.Num()] - Points[i];
+		Normals.Add(FVector2f(Edge.Y, -Edge.X).GetSafeNormal() * Winding);
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FSATHull& Hull)
+{
+	Ar << Hull.Bounds;
+	Ar << Hull.QuantizedPoints;
+
+	if (Ar.IsLoading())
+	{
+		Hull.Decode();
+	}
+	return Ar;
+}
@@ -0,0 +1,64 @@
+#include "SATHullAsset.h"
+
+void USATHullAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	bool bHasHull = Hull.IsValid();
+	Ar << bHasHull;
+
+	if (Ar.IsLoading())
+	{
+		Hull.Reset();
+		if (bHasHull)
+		{
+			TSharedRef<FSATHull> Loaded = MakeShared<FSATHull>();
+			Ar << *Loaded;
+
+#if !WITH_EDITOR
+			// Nothing saves the asset again outside the editor, so the decoded copy is all that is needed
+			Loaded->QuantizedPoints.Empty();
+#endif
+			Hull = Loaded;
+		}
+	}
+	else if (bHasHull)
+	{
+		FSATHull Saved = *Hull;
+		Ar << Saved;
+	}
+}
+
+#if WITH_EDITOR
+void USATHullAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	if (!Hull.IsValid() && Points.Num() > 0)
+	{
+		Hull = FSATHull::Build(Points);
+	}
+}
+
+void USATHullAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Shapes already holding the old hull keep it until their next gather
+	Hull.Reset();
+	if (Points.Num() > 0)
+	{
+		Hull = FSATHull::Build(Points);
+	}
+}
+#endif
+
+void USATHullAsset::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	if (Hull.IsValid())
+	{
+		CumulativeResourceSize.AddDedicatedSystemMemoryBytes(sizeof(FSATHull) + Hull->GetAllocatedSize());
+	}
+}
@@ -0,0 +1,179 @@
+#include "SATReplayCommandlet.h"
+
+#include "SATCollisionSnapshot.h"
+#include "SATCollisionSubsystem.h"
+
+namespace
+{
+	using FSATIdPair = TPair<uint32, uint32>;
+
+	FSATIdPair GetContactIds(const FSATFrameState& Frame, const FSATContact& Contact)
+	{
+		const uint32 IdA = Frame.Shapes[Contact.ShapeA].Id;
+		const uint32 IdB = Frame.Shapes[Contact.ShapeB].Id;
+		return IdA < IdB ? MakeTuple(IdA, IdB) : MakeTuple(IdB, IdA);
+	}
+
+	// Returns the number of contacts/events that differ between the recording and the replay
+	int32 CompareFrames(const FSATFrameState& Recorded, const FSATFrameState& Replayed, float Tolerance)
+	{
+		int32 NumDifferences = 0;
+
+		TMap<FSATIdPair, const FSATContact*> ReplayedContacts;
+		for (const FSATContact& Contact : Replayed.Contacts)
+		{
+			ReplayedContacts.Add(GetContactIds(Replayed, Contact), &Contact);
+		}
+
+		for (const FSATContact& Contact : Recorded.Contacts)
+		{
+			const FSATIdPair Ids = GetContactIds(Recorded, Contact);
+			const FSATContact* Other = ReplayedContacts.FindRef(Ids);
+
+			if (!Other)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Frame %llu: contact %u-%u is missing from the replay"),
+				       Recorded.FrameNumber, Ids.Key, Ids.Value);
+				++NumDifferences;
+			}
+			else if (!FMath::IsNearlyEqual(Contact.Overlap, Other->Overlap, Tolerance)
+				|| !Contact.Axis.Equals(Other->Axis, Tolerance))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Frame %llu: contact %u-%u recorded axis %s overlap %f, replayed axis %s overlap %f"),
+				       Recorded.FrameNumber, Ids.Key, Ids.Value,
+				       *Contact.Axis.ToString(), Contact.Overlap, *Other->Axis.ToString(), Other->Overlap);
+				++NumDifferences;
+			}
+
+			ReplayedContacts.Remove(Ids);
+		}
+
+		for (const TPair<FSATIdPair, const FSATContact*>& Extra : ReplayedContacts)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Frame %llu: replay found contact %u-%u that was not recorded"),
+			       Recorded.FrameNumber, Extra.Key.Key, Extra.Key.Value);
+			++NumDifferences;
+		}
+
+		auto SortEvents = [](TArray<FSATEventRecord> Events)
+		{
+			Events.Sort([](const FSATEventRecord& A, const FSATEventRecord& B)
+			{
+				if (A.IdA != B.IdA) return A.IdA < B.IdA;
+				if (A.IdB != B.IdB) return A.IdB < B.IdB;
+				return A.bBegin < B.bBegin;
+			});
+			return Events;
+		};
+
+		const TArray<FSATEventRecord> RecordedEvents = SortEvents(Recorded.Events);
+		const TArray<FSATEventRecord> ReplayedEvents = SortEvents(Replayed.Events);
+
+		bool bEventsMatch = RecordedEvents.Num() == ReplayedEvents.Num();
+		for (int32 i = 0; bEventsMatch && i < RecordedEvents.Num(); ++i)
+		{
+			bEventsMatch = RecordedEvents[i].IdA == ReplayedEvents[i].IdA
+				&& RecordedEvents[i].IdB == ReplayedEvents[i].IdB
+				&& RecordedEvents[i].bBegin == ReplayedEvents[i].bBegin;
+		}
+
+		if (!bEventsMatch)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Frame %llu: recorded %d begin/end events, replay produced %d different ones"),
+			       Recorded.FrameNumber, RecordedEvents.Num(), ReplayedEvents.Num());
+			++NumDifferences;
+		}
+
+		return NumDifferences;
+	}
+}
+
+int32 FSATReplaySession::ReplayFrame(const FSATFrameState& Recorded, FSATFrameState& OutReplayed, float Tolerance,
+                                     int32 Repeat, double& OutSeconds)
+{
+	// Dormant pairs in the first frame carry contacts from before the recording started, which are
+	// in that frame's own results
+	if (!bStarted)
+	{
+		BroadPhase.StoreContacts(Recorded);
+		bStarted = true;
+	}
+
+	OutSeconds = 0.0;
+	for (int32 Run = 0; Run < Repeat; ++Run)
+	{
+		OutReplayed = Recorded;
+		OutReplayed.ResetResults();
+
+		const double StartSeconds = FPlatformTime::Seconds();
+		USATCollisionSubsystem::DetectCollisions(OutReplayed, &BroadPhase);
+		OutSeconds += FPlatformTime::Seconds() - StartSeconds;
+	}
+	OutSeconds /= FMath::Max(Repeat, 1);
+
+	OutReplayed.BuildEvents(OverlapIds);
+	return CompareFrames(Recorded, OutReplayed, Tolerance);
+}
+
+USATReplayCommandlet::USATReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USATReplayCommandlet::Main(const FString& Params)
+{
+	FString Filename;
+	if (!FParse::Value(*Params, TEXT("File="), Filename))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: -run=SATReplay -File=<Recording> [-Repeat=<N>] [-Tolerance=<T>]"));
+		return 1;
+	}
+
+	int32 Repeat = 1;
+	float Tolerance = 0.01f;
+	FParse::Value(*Params, TEXT("Repeat="), Repeat);
+	FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+	Repeat = FMath::Max(Repeat, 1);
+
+	FSATCollisionReplayReader Reader;
+	if (!Reader.Open(Filename))
+	{
+		return 1;
+	}
+
+	FSATFrameState Recorded;
+	FSATFrameState Replayed;
+	FSATReplaySession Session;
+
+	int32 NumFrames = 0;
+	int32 NumMismatchedFrames = 0;
+	double TotalSeconds = 0.0;
+	double WorstSeconds = 0.0;
+	uint64 WorstFrame = 0;
+
+	while (Reader.ReadFrame(Recorded))
+	{
+		double FrameSeconds = 0.0;
+		if (Session.ReplayFrame(Recorded, Replayed, Tolerance, Repeat, FrameSeconds) > 0)
+		{
+			++NumMismatchedFrames;
+		}
+
+		if (FrameSeconds > WorstSeconds)
+		{
+			WorstSeconds = FrameSeconds;
+			WorstFrame = Recorded.FrameNumber;
+		}
+		TotalSeconds += FrameSeconds;
+		++NumFrames;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("SAT replay of %s: %d frames, %d mismatched, avg %.3f ms, worst %.3f ms (frame %llu)"),
+	       *Filename, NumFrames, NumMismatchedFrames,
+	       NumFrames > 0 ? TotalSeconds * 1000.0 / NumFrames : 0.0, WorstSeconds * 1000.0, WorstFrame);
+
+	return NumMismatchedFrames == 0 ? 0 : 1;
+}
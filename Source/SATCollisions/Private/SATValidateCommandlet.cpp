@@ -0,0 +1,503 @@
+#include "SATValidateCommandlet.h"
+
+#include "Capsule2D.h"
+#include "Circle2D.h"
+#include "OrientedBox2D.h"
+#include "SATBroadPhase.h"
+#include "SATCollisionSnapshot.h"
+#include "SATCollisionSubsystem.h"
+#include "SATHull.h"
+
+namespace
+{
+	const TCHAR* const ShapeTypeNames[SATNumShapeTypes] = { TEXT("Polygon"), TEXT("Circle"), TEXT("Capsule"), TEXT("Box") };
+
+	// Outline vertices of a circle or capsule cap in the reference. Being inscribed, they make the
+	// reference at most Radius * (1 - cos(PI / ReferenceSegments)) shallower than the real shape.
+	constexpr int32 ReferenceSegments = 64;
+
+	// Pairs are generated around the world origin, on a region corner and far from the origin
+	const FVector2D TestSites[] =
+	{
+		FVector2D(0.0, 0.0),
+		FVector2D(0.5 * SATRegionSize, -0.5 * SATRegionSize),
+		FVector2D(1.0e6 + 0.5 * SATRegionSize, 3.0e5),
+		FVector2D(-2.0e7, 2.0e7 + 0.5 * SATRegionSize)
+	};
+
+	// A shape as authored on its actor: the actor's transform and the shape's own properties
+	struct FAuthoredShape
+	{
+		ESATShapeType Type = ESATShapeType::Polygon;
+		FTransform Transform;
+		TArray<FVector2D> Points;
+		TSharedPtr<const FSATHull> Hull;
+		FVector2D Offset = FVector2D::ZeroVector; // Circle X and Y
+		float Radius = 0.f;
+		float HalfLength = 0.f;
+		FVector2D HalfExtents = FVector2D::ZeroVector;
+	};
+
+	FAuthoredShape MakeRandomShape(FRandomStream& Random, ESATShapeType Type, const FVector2D& Site)
+	{
+		FAuthoredShape Shape;
+		Shape.Type = Type;
+
+		// Rotated, non-uniformly scaled and sometimes mirrored, which flips a polygon's winding
+		const FVector2D Location = Site + FVector2D(Random.FRandRange(-60.f, 60.f), Random.FRandRange(-60.f, 60.f));
+		FVector Scale(Random.FRandRange(0.5f, 1.5f), Random.FRandRange(0.5f, 1.5f), 1.f);
+		if (Random.FRand() < 0.25f) Scale.X = -Scale.X;
+		Shape.Transform = FTransform(FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f), FVector(Location, 0.f), Scale);
+
+		switch (Type)
+		{
+		case ESATShapeType::Polygon:
+		{
+			// Convex by construction: jittered, evenly spaced angles around a circle
+			const int32 NumPoints = Random.RandRange(3, 8);
+			const float Radius = Random.FRandRange(10.f, 40.f);
+			const float Angle = Random.FRandRange(0.f, UE_TWO_PI);
+			TArray<FVector2D> Points;
+			for (int32 i = 0; i < NumPoints; ++i)
+			{
+				const float PointAngle = Angle + i * UE_TWO_PI / NumPoints + Random.FRandRange(-0.2f, 0.2f);
+				Points.Add(FVector2D(FMath::Cos(PointAngle), FMath::Sin(PointAngle)) * Radius);
+			}
+
+			if (Random.FRand() < 0.5f)
+			{
+				Shape.Hull = FSATHull::Build(Points);
+			}
+			else
+			{
+				Shape.Points = MoveTemp(Points);
+			}
+			break;
+		}
+		case ESATShapeType::Circle:
+			Shape.Offset = FVector2D(Random.FRandRange(-20.f, 20.f), Random.FRandRange(-20.f, 20.f));
+			Shape.Radius = Random.FRandRange(5.f, 30.f);
+			break;
+		case ESATShapeType::Capsule:
+			Shape.HalfLength = Random.FRandRange(0.f, 30.f);
+			Shape.Radius = Random.FRandRange(5.f, 20.f);
+			break;
+		case ESATShapeType::Box:
+			Shape.HalfExtents = FVector2D(Random.FRandRange(5.f, 40.f), Random.FRandRange(5.f, 40.f));
+			break;
+		}
+
+		return Shape;
+	}
+
+	// What USATCollisionSubsystem::GatherFrameState reads from the actor, through the actors' own
+	// world data math
+	FSATShapeState GatherShape(const FAuthoredShape& Authored, uint32 Id, ESATCollisionResponse Response)
+	{
+		FSATShapeState Shape;
+		Shape.Id = Id;
+		Shape.Type = Authored.Type;
+		Shape.Response = Response;
+		Shape.Transform = Authored.Transform;
+
+		switch (Authored.Type)
+		{
+		case ESATShapeType::Polygon:
+			Shape.Points = Authored.Points;
+			Shape.Hull = Authored.Hull;
+			break;
+		case ESATShapeType::Circle:
+			ACircle2D::ComputeWorldCircle(Authored.Transform, Authored.Offset.X, Authored.Offset.Y, Authored.Radius, Shape.Center, Shape.Radius);
+			break;
+		case ESATShapeType::Capsule:
+		{
+			FVector2D Start, End;
+			ACapsule2D::ComputeWorldCapsule(Authored.Transform, Authored.HalfLength, Authored.Radius, Start, End, Shape.Radius);
+			Shape.Points = { Start, End };
+			break;
+		}
+		case ESATShapeType::Box:
+			AOrientedBox2D::ComputeWorldBox(Authored.Transform, Authored.HalfExtents, Shape.Center, Shape.HalfExtents, Shape.AxisX);
+			break;
+		}
+
+		return Shape;
+	}
+
+	void AddArc(TArray<FVector2D>& Outline, const FVector2D& Center, float Radius, double StartAngle, double Sweep, int32 NumSegments)
+	{
+		for (int32 i = 0; i <= NumSegments; ++i)
+		{
+			const double Angle = StartAngle + Sweep * i / NumSegments;
+			Outline.Add(Center + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius);
+		}
+	}
+
+	// World-space outline of an authored shape, transformed straight from its properties in double
+	// precision without the actors' world data or FSATShapeState::UpdateWorldData
+	TArray<FVector2D> GetReferenceOutline(const FAuthoredShape& Shape)
+	{
+		TArray<FVector2D> Outline;
+		auto TransformPoint = [&Shape](double X, double Y)
+		{
+			return FVector2D(Shape.Transform.TransformPosition(FVector(X, Y, 0.0)));
+		};
+
+		// Round shapes take the larger axis under non-uniform scale rather than becoming ellipses
+		const double RadiusScale = FMath::Max(Shape.Transform.TransformVector(FVector(1.0, 0.0, 0.0)).Size2D(),
+		                                      Shape.Transform.TransformVector(FVector(0.0, 1.0, 0.0)).Size2D());
+
+		switch (Shape.Type)
+		{
+		case ESATShapeType::Polygon:
+			if (Shape.Hull.IsValid())
+			{
+				for (const FVector2f& Point : Shape.Hull->Points)
+				{
+					Outline.Add(TransformPoint(Point.X, Point.Y));
+				}
+			}
+			else
+			{
+				for (const FVector2D& Point : Shape.Points)
+				{
+					Outline.Add(TransformPoint(Point.X, Point.Y));
+				}
+			}
+			break;
+		case ESATShapeType::Circle:
+			AddArc(Outline, TransformPoint(Shape.Offset.X, Shape.Offset.Y), Shape.Radius * RadiusScale, 0.0,
+			       UE_DOUBLE_TWO_PI * (ReferenceSegments - 1) / ReferenceSegments, ReferenceSegments - 1);
+			break;
+		case ESATShapeType::Capsule:
+		{
+			const FVector2D Start = TransformPoint(-Shape.HalfLength, 0.0);
+			const FVector2D End = TransformPoint(Shape.HalfLength, 0.0);
+			const FVector2D Axis = End - Start;
+			const double Angle = Axis.IsNearlyZero() ? 0.0 : FMath::Atan2(Axis.Y, Axis.X);
+			AddArc(Outline, End, Shape.Radius * RadiusScale, Angle - UE_DOUBLE_HALF_PI, UE_DOUBLE_PI, ReferenceSegments / 2);
+			AddArc(Outline, Start, Shape.Radius * RadiusScale, Angle + UE_DOUBLE_HALF_PI, UE_DOUBLE_PI, ReferenceSegments / 2);
+			break;
+		}
+		case ESATShapeType::Box:
+		{
+			const FVector2D& Extents = Shape.HalfExtents;
+			Outline = { TransformPoint(-Extents.X, -Extents.Y), TransformPoint(Extents.X, -Extents.Y),
+			            TransformPoint(Extents.X, Extents.Y), TransformPoint(-Extents.X, Extents.Y) };
+			break;
+		}
+		}
+
+		return Outline;
+	}
+
+	// Brute-force SAT over every edge normal of both outlines, without early outs. Returns the
+	// smallest overlap, negative when separated, and its axis pointing from A to B.
+	double ReferenceOverlap(const TArray<FVector2D>& A, const TArray<FVector2D>& B, FVector2D& OutAxis)
+	{
+		double MinOverlap = TNumericLimits<double>::Max();
+		OutAxis = FVector2D::ZeroVector;
+
+		auto Project = [](const TArray<FVector2D>& Outline, const FVector2D& Axis, double& OutMin, double& OutMax)
+		{
+			OutMin = TNumericLimits<double>::Max();
+			OutMax = -TNumericLimits<double>::Max();
+			for (const FVector2D& Point : Outline)
+			{
+				const double Projection = FVector2D::DotProduct(Point, Axis);
+				OutMin = FMath::Min(OutMin, Projection);
+				OutMax = FMath::Max(OutMax, Projection);
+			}
+		};
+
+		for (const TArray<FVector2D>* Outline : { &A, &B })
+		{
+			for (int32 i = 0; i < Outline->Num(); ++i)
+			{
+				const FVector2D Edge = (*Outline)[(i + 1) % Outline->Num()] - (*Outline)[i];
+				const FVector2D Normal = FVector2D(-Edge.Y, Edge.X).GetSafeNormal();
+				if (Normal.IsZero()) continue;
+
+				double MinA, MaxA, MinB, MaxB;
+				Project(A, Normal, MinA, MaxA);
+				Project(B, Normal, MinB, MaxB);
+
+				const double Overlap = FMath::Min(MaxA - MinB, MaxB - MinA);
+				if (Overlap < MinOverlap)
+				{
+					MinOverlap = Overlap;
+					OutAxis = MaxA - MinB < MaxB - MinA ? Normal : -Normal;
+				}
+			}
+		}
+
+		return MinOverlap;
+	}
+
+	// How far Point is outside a convex outline, negative inside
+	double ReferenceDistance(const TArray<FVector2D>& Outline, const FVector2D& Point)
+	{
+		FVector2D Centroid = FVector2D::ZeroVector;
+		for (const FVector2D& Vertex : Outline)
+		{
+			Centroid += Vertex / Outline.Num();
+		}
+
+		double Distance = -TNumericLimits<double>::Max();
+		for (int32 i = 0; i < Outline.Num(); ++i)
+		{
+			const FVector2D Edge = Outline[(i + 1) % Outline.Num()] - Outline[i];
+			FVector2D Normal = FVector2D(-Edge.Y, Edge.X).GetSafeNormal();
+			if (Normal.IsZero()) continue;
+			if (FVector2D::DotProduct(Normal, Centroid - Outline[i]) > 0.0) Normal = -Normal;
+
+			Distance = FMath::Max(Distance, FVector2D::DotProduct(Normal, Point - Outline[i]));
+		}
+		return Distance;
+	}
+
+	struct FPairStats
+	{
+		int32 NumHits = 0;
+		int32 NumTouching = 0;
+		int32 NumHitMismatches = 0;
+		int32 NumOverlapOnlyMismatches = 0;
+		int32 NumDepthMismatches = 0;
+		int32 NumAxisMismatches = 0;
+		int32 NumPointMismatches = 0;
+
+		int32 GetNumFailures() const
+		{
+			return NumHitMismatches + NumOverlapOnlyMismatches + NumDepthMismatches + NumAxisMismatches + NumPointMismatches;
+		}
+	};
+
+	TSet<TPair<uint32, uint32>> GetContactIds(const FSATFrameState& Frame)
+	{
+		TSet<TPair<uint32, uint32>> Ids;
+		for (const FSATContact& Contact : Frame.Contacts)
+		{
+			const uint32 IdA = Frame.Shapes[Contact.ShapeA].Id;
+			const uint32 IdB = Frame.Shapes[Contact.ShapeB].Id;
+			Ids.Add(IdA < IdB ? MakeTuple(IdA, IdB) : MakeTuple(IdB, IdA));
+		}
+		return Ids;
+	}
+
+	// Moves crowds of shapes of every type through a persistent FSATBroadPhase for a few frames, with
+	// random shapes dormant, and compares its contacts with testing every pair: a pair with a shape
+	// that is not dormant has to match, a pair of dormant shapes has to keep last frame's result. The
+	// shapes only overlap, since the order Block pairs are resolved in would change the result.
+	int32 ValidateBroadPhase(FRandomStream& Random, int32 NumScenes)
+	{
+		constexpr int32 NumShapes = 32;
+		constexpr int32 NumFrames = 8;
+		int32 NumFailures = 0;
+
+		for (int32 Scene = 0; Scene < NumScenes; ++Scene)
+		{
+			const FVector2D& Site = TestSites[Scene % UE_ARRAY_COUNT(TestSites)];
+
+			TArray<FAuthoredShape> Shapes;
+			for (int32 i = 0; i < NumShapes; ++i)
+			{
+				const FVector2D Spread(Random.FRandRange(-200.f, 200.f), Random.FRandRange(-200.f, 200.f));
+				Shapes.Add(MakeRandomShape(Random, static_cast<ESATShapeType>(Random.RandHelper(SATNumShapeTypes)), Site + Spread));
+			}
+
+			FSATBroadPhase BroadPhase;
+			TSet<TPair<uint32, uint32>> LastIds;
+
+			for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+			{
+				FSATFrameState Frame;
+				FSATFrameState FullFrame;
+				for (int32 i = 0; i < NumShapes; ++i)
+				{
+					// Small steps stay inside the tree's fat bounds, large ones leave them
+					const float Step = Random.FRand() < 0.2f ? 80.f : 5.f;
+					Shapes[i].Transform.AddToTranslation(FVector(Random.FRandRange(-Step, Step), Random.FRandRange(-Step, Step), 0.f));
+
+					FSATShapeState& Shape = Frame.Shapes.Add_GetRef(GatherShape(Shapes[i], i + 1, ESATCollisionResponse::Overlap));
+					FullFrame.Shapes.Add(Shape);
+					Shape.bDormant = FrameIndex > 0 && Random.FRand() < 0.5f;
+				}
+
+				USATCollisionSubsystem::DetectCollisions(Frame, &BroadPhase);
+				USATCollisionSubsystem::DetectCollisions(FullFrame);
+
+				auto IsDormantPair = [&Frame](const TPair<uint32, uint32>& Ids)
+				{
+					return Frame.Shapes[Ids.Key - 1].bDormant && Frame.Shapes[Ids.Value - 1].bDormant;
+				};
+
+				TSet<TPair<uint32, uint32>> ExpectedIds;
+				for (const TPair<uint32, uint32>& Ids : GetContactIds(FullFrame))
+				{
+					if (!IsDormantPair(Ids)) ExpectedIds.Add(Ids);
+				}
+				for (const TPair<uint32, uint32>& Ids : LastIds)
+				{
+					if (IsDormantPair(Ids)) ExpectedIds.Add(Ids);
+				}
+
+				const TSet<TPair<uint32, uint32>> Ids = GetContactIds(Frame);
+				const int32 NumMismatches = Ids.Difference(ExpectedIds).Num() + ExpectedIds.Difference(Ids).Num();
+				if (NumMismatches > 0 && ++NumFailures <= 3)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("Broad phase scene %d frame %d: %d contacts, %d expected, %d differ"),
+					       Scene, FrameIndex, Ids.Num(), ExpectedIds.Num(), NumMismatches);
+				}
+
+				LastIds = Ids;
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Broad phase: %d scenes of %d shapes over %d frames, %d failing frames"),
+		       NumScenes, NumShapes, NumFrames, NumFailures);
+		return NumFailures;
+	}
+}
+
+USATValidateCommandlet::USATValidateCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USATValidateCommandlet::Main(const FString& Params)
+{
+	int32 Iterations = 100000;
+	int32 Seed = 0;
+	float Tolerance = 0.1f;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+
+	return RunValidation(Iterations, Seed, Tolerance) == 0 ? 0 : 1;
+}
+
+int32 USATValidateCommandlet::RunValidation(int32 Iterations, int32 Seed, float Tolerance)
+{
+	FRandomStream Random(Seed);
+	int32 NumFailures = 0;
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	for (int32 TypeA = 0; TypeA < SATNumShapeTypes; ++TypeA)
+	{
+		for (int32 TypeB = 0; TypeB < SATNumShapeTypes; ++TypeB)
+		{
+			FPairStats Stats;
+
+			auto Fail = [&](int32& Counter, int32 Iteration, const TCHAR* What, double Fast, double Reference)
+			{
+				// The first few are enough to reproduce with the same seed
+				if (++Counter <= 3)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("%s-%s pair %d: %s, fast %f, reference %f"),
+					       ShapeTypeNames[TypeA], ShapeTypeNames[TypeB], Iteration, What, Fast, Reference);
+				}
+			};
+
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				const FVector2D& Site = TestSites[Iteration % UE_ARRAY_COUNT(TestSites)];
+
+				const FAuthoredShape Authored[2] =
+				{
+					MakeRandomShape(Random, static_cast<ESATShapeType>(TypeA), Site),
+					MakeRandomShape(Random, static_cast<ESATShapeType>(TypeB), Site)
+				};
+
+				FSATFrameState Frame;
+				Frame.Shapes.Add(GatherShape(Authored[0], 1, ESATCollisionResponse::Block));
+				Frame.Shapes.Add(GatherShape(Authored[1], 2, ESATCollisionResponse::Block));
+
+				FSATFrameState OverlapFrame = Frame;
+				for (FSATShapeState& Shape : OverlapFrame.Shapes)
+				{
+					Shape.Response = ESATCollisionResponse::Overlap;
+				}
+
+				const TArray<FVector2D> Outlines[2] = { GetReferenceOutline(Authored[0]), GetReferenceOutline(Authored[1]) };
+				FVector2D ReferenceAxis;
+				const double Overlap = ReferenceOverlap(Outlines[0], Outlines[1], ReferenceAxis);
+
+				USATCollisionSubsystem::DetectCollisions(Frame);
+				USATCollisionSubsystem::DetectCollisions(OverlapFrame);
+
+				// Barely touching or barely apart can go either way within the tolerance
+				if (FMath::Abs(Overlap) <= Tolerance)
+				{
+					++Stats.NumTouching;
+					continue;
+				}
+
+				const bool bReferenceHit = Overlap > 0.0;
+				const bool bHit = Frame.Contacts.Num() > 0;
+				if (bHit != bReferenceHit)
+				{
+					Fail(Stats.NumHitMismatches, Iteration, TEXT("hit/miss"), bHit, bReferenceHit);
+					continue;
+				}
+
+				if ((OverlapFrame.Contacts.Num() > 0) != bReferenceHit)
+				{
+					Fail(Stats.NumOverlapOnlyMismatches, Iteration, TEXT("overlap-only hit/miss"), OverlapFrame.Contacts.Num() > 0, bReferenceHit);
+				}
+
+				if (!bHit) continue;
+				++Stats.NumHits;
+
+				const FSATContact& Contact = Frame.Contacts[0];
+				const TArray<FVector2D>& OutlineA = Outlines[Contact.ShapeA];
+				const TArray<FVector2D>& OutlineB = Outlines[Contact.ShapeB];
+
+				// The round shapes' outlines are slightly inscribed, hence the relative slack
+				if (FMath::Abs(Contact.Overlap - Overlap) > Tolerance + 0.01 * Overlap)
+				{
+					Fail(Stats.NumDepthMismatches, Iteration, TEXT("depth"), Contact.Overlap, Overlap);
+				}
+
+				// The fast axis may differ from the reference's when two axes tie, but moving B by the
+				// contact's MTV has to separate the pair either way
+				TArray<FVector2D> MovedB = OutlineB;
+				for (FVector2D& Point : MovedB)
+				{
+					Point += Contact.Axis * (Contact.Overlap + Tolerance);
+				}
+				FVector2D MovedAxis;
+				const double MovedOverlap = ReferenceOverlap(OutlineA, MovedB, MovedAxis);
+				if (!FMath::IsNearlyEqual(Contact.Axis.Size(), 1.0, 1.e-3) || MovedOverlap > Tolerance)
+				{
+					Fail(Stats.NumAxisMismatches, Iteration, TEXT("axis does not separate"), Contact.Axis.Size(), MovedOverlap);
+				}
+
+				// Points lie between both surfaces, no deeper than the contact
+				for (int32 i = 0; i < Contact.NumPoints; ++i)
+				{
+					const FSATContactPoint& Point = Contact.Points[i];
+					const double Distance = FMath::Max(ReferenceDistance(OutlineA, Point.Position), ReferenceDistance(OutlineB, Point.Position));
+					if (Point.Depth < -Tolerance || Point.Depth > Contact.Overlap + Tolerance || Distance > Contact.Overlap + Tolerance)
+					{
+						Fail(Stats.NumPointMismatches, Iteration, TEXT("contact point"), Point.Depth, Distance);
+					}
+				}
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("%s-%s: %d pairs, %d hits, %d touching, failures: %d hit/miss, %d overlap-only, %d depth, %d axis, %d points"),
+			       ShapeTypeNames[TypeA], ShapeTypeNames[TypeB], Iterations, Stats.NumHits, Stats.NumTouching,
+			       Stats.NumHitMismatches, Stats.NumOverlapOnlyMismatches, Stats.NumDepthMismatches, Stats.NumAxisMismatches, Stats.NumPointMismatches);
+			NumFailures += Stats.GetNumFailures();
+		}
+	}
+
+	NumFailures += ValidateBroadPhase(Random, FMath::Max(Iterations / 200, 1));
+
+	UE_LOG(LogTemp, Display, TEXT("SAT validation (seed %d, tolerance %f): %d failures in %.1f s"),
+	       Seed, Tolerance, NumFailures, FPlatformTime::Seconds() - StartSeconds);
+
+	return NumFailures;
+}
@@ -0,0 +1,18 @@
+#include "Misc/AutomationTest.h"
+#include "SATValidateCommandlet.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSATNarrowPhaseValidationTest, "SATCollisions.NarrowPhase.Validation",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSATNarrowPhaseValidationTest::RunTest(const FString& Parameters)
+{
+	// Same check as -run=SATValidate, with few enough pairs for a regular test pass. Use the
+	// commandlet for long soak runs over other seeds.
+	const int32 NumFailures = USATValidateCommandlet::RunValidation(2000, 0, 0.1f);
+	TestEqual(TEXT("Pairs disagreeing with the reference"), NumFailures, 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,79 @@
+#include "Misc/AutomationTest.h"
+#include "SATCollisionSubsystem.h"
+#include "SATReplayCommandlet.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSATReplayMidSessionLODTest, "SATCollisions.Replay.MidSessionLOD",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSATReplayMidSessionLODTest::RunTest(const FString& Parameters)
+{
+	// Eight overlapping circle pairs, all far from the players and tested in turns like
+	// USATCollisionSubsystem::ScheduleShapes does
+	constexpr uint32 Interval = 4;
+	auto MakeFrame = [](uint64 FrameNumber)
+	{
+		FSATFrameState Frame;
+		Frame.FrameNumber = FrameNumber;
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			FSATShapeState& Shape = Frame.Shapes.AddDefaulted_GetRef();
+			Shape.Id = i + 1;
+			Shape.Type = ESATShapeType::Circle;
+			Shape.Response = ESATCollisionResponse::Overlap;
+			Shape.Center = FVector2D((i / 2) * 100.0 + (i % 2) * 15.0, 0.0);
+			Shape.Radius = 10.f;
+			Shape.ScheduleSlot = i;
+			Shape.bDormant = (Shape.ScheduleSlot + FrameNumber) % Interval != 0;
+		}
+		return Frame;
+	};
+
+	// The live session runs for a while before the recording starts, so the first recorded frame's
+	// dormant pairs carry contacts the replay never detected itself
+	FSATBroadPhase LiveBroadPhase;
+	TSet<TPair<uint32, uint32>> RecordedOverlapIds;
+	TArray<FSATFrameState> Recording;
+
+	for (uint64 FrameNumber = 0; FrameNumber < 12; ++FrameNumber)
+	{
+		FSATFrameState Frame = MakeFrame(FrameNumber);
+		USATCollisionSubsystem::DetectCollisions(Frame, &LiveBroadPhase);
+		if (FrameNumber < 5) continue;
+
+		// Same as the subsystem's recorder: events relative to the start of the recording, and the
+		// frame written to and read back from a stream
+		Frame.BuildEvents(RecordedOverlapIds);
+
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Writer << Frame;
+
+		FMemoryReader Reader(Bytes);
+		Reader << Recording.AddDefaulted_GetRef();
+	}
+
+	const FSATFrameState& First = Recording[0];
+	const bool bHasCarriedContact = First.Contacts.ContainsByPredicate([&First](const FSATContact& Contact)
+	{
+		return First.Shapes[Contact.ShapeA].bDormant && First.Shapes[Contact.ShapeB].bDormant;
+	});
+	TestTrue(TEXT("First recorded frame has a contact between two dormant shapes"), bHasCarriedContact);
+
+	FSATReplaySession Session;
+	int32 NumDifferences = 0;
+	for (const FSATFrameState& Recorded : Recording)
+	{
+		FSATFrameState Replayed;
+		double Seconds = 0.0;
+		NumDifferences += Session.ReplayFrame(Recorded, Replayed, 0.01f, 1, Seconds);
+	}
+	TestEqual(TEXT("Contacts and events differing from the recording"), NumDifferences, 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SATCollisionTypes.h"
+#include "GameFramework/Actor.h"
+#include "Capsule2D.generated.h"
+
+UCLASS()
+class ACapsule2D : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ACapsule2D();
+
+protected:
+	virtual void BeginPlay() override;
+
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	UPROPERTY()
+	USceneComponent* Root;
+
+	// Half the length of the capsule's core segment, which runs along the actor's local X axis
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetHalfLength, Category = "Capsule")
+	float HalfLength = 50.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetRadius, Category = "Capsule")
+	float Radius = 25.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capsule Debug")
+	int32 Segments = 16;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capsule Debug")
+	FColor ShapeColor = FColor::Green;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Capsule Debug")
+	float ZOffset = 10.f;
+
+	UFUNCTION(BlueprintCallable, Category = "Capsule")
+	void SetCapsule(float InHalfLength, float InRadius);
+
+	UFUNCTION(BlueprintSetter)
+	void SetHalfLength(float InHalfLength);
+
+	UFUNCTION(BlueprintSetter)
+	void SetRadius(float InRadius);
+
+	// World-space core segment and radius, refreshed whenever the actor's transform or the capsule changes,
+	// including direct writes to HalfLength or Radius. Non-uniform XY scale is covered by scaling the
+	// radius with the larger axis.
+	FVector2D GetWorldStart() const { RefreshWorldCapsule(); return WorldStart; }
+	FVector2D GetWorldEnd() const { RefreshWorldCapsule(); return WorldEnd; }
+	float GetWorldRadius() const { RefreshWorldCapsule(); return WorldRadius; }
+
+	// The world capsule of an actor at Transform, also used by the validation commandlet
+	static void ComputeWorldCapsule(const FTransform& Transform, float InHalfLength, float InRadius,
+	                                FVector2D& OutStart, FVector2D& OutEnd, float& OutRadius);
+
+	void SetColliding(bool bColliding)
+	{
+		ShapeColor = bColliding ? FColor::Red : FColor::Green;
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SAT Collision")
+	ESATCollisionResponse CollisionResponse = ESATCollisionResponse::Overlap;
+
+	// Slot in USATCollisionSubsystem's registry, INDEX_NONE while unregistered
+	int32 SATHandle = INDEX_NONE;
+
+	// Registration order, which spreads shapes evenly over the LOD scheduler's round robin
+	uint32 SATScheduleSlot = 0;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSATOverlapEvent, AActor*, OtherActor);
+
+	UPROPERTY(BlueprintAssignable, Category = "SAT Collision")
+	FSATOverlapEvent OnSATOverlapBeginDelegate;
+
+	UPROPERTY(BlueprintAssignable, Category = "SAT Collision")
+	FSATOverlapEvent OnSATOverlapEndDelegate;
+
+	UFUNCTION()
+	void HandleSATOverlapBegin(AActor* OtherActor);
+
+	UFUNCTION()
+	void HandleSATOverlapEnd(AActor* OtherActor);
+
+protected:
+	UFUNCTION(BlueprintNativeEvent, Category = "SAT Collision")
+	void OnSATOverlapBegin(AActor* OtherActor);
+	virtual void OnSATOverlapBegin_Implementation(AActor* OtherActor);
+
+	UFUNCTION(BlueprintNativeEvent, Category = "SAT Collision")
+	void OnSATOverlapEnd(AActor* OtherActor);
+	virtual void OnSATOverlapEnd_Implementation(AActor* OtherActor);
+
+private:
+	void DrawDebugCapsule2D() const;
+
+	void UpdateWorldCapsule() const;
+
+	// Rebuilds the world capsule if HalfLength or Radius were written without a setter since the last build
+	void RefreshWorldCapsule() const;
+
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	// Mutable so the getters can catch up with direct writes. Built* are the values it was built from.
+	mutable FVector2D WorldStart = FVector2D::ZeroVector;
+	mutable FVector2D WorldEnd = FVector2D::ZeroVector;
+	mutable float WorldRadius = 0.f;
+	mutable float BuiltHalfLength = 0.f;
+	mutable float BuiltRadius = 0.f;
+};
@@ -16,6 +16,12 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
@@ -24,13 +30,13 @@ public:
 	UPROPERTY()
 	USceneComponent* Root;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Circle")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetX, Category = "Circle")
 	float X = 0.f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Circle")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetY, Category = "Circle")
 	float Y = 0.f;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Circle")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetRadius, Category = "Circle")
 	float Radius = 100.f;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Circle Debug")
@@ -45,6 +51,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Circle")
 	void SetCircle(float InX, float InY, float InRadius);
 
+	UFUNCTION(BlueprintSetter)
+	void SetX(float InX);
+
+	UFUNCTION(BlueprintSetter)
+	void SetY(float InY);
+
+	UFUNCTION(BlueprintSetter)
+	void SetRadius(float InRadius);
+
+	// World-space circle, refreshed whenever the actor's transform or the circle changes, including
+	// direct writes to X, Y or Radius. Non-uniform XY scale is covered by scaling the radius with the
+	// larger axis.
+	FVector2D GetWorldCenter() const { RefreshWorldCircle(); return WorldCenter; }
+	float GetWorldRadius() const { RefreshWorldCircle(); return WorldRadius; }
+
+	// The world circle of an actor at Transform, also used by the validation commandlet
+	static void ComputeWorldCircle(const FTransform& Transform, float InX, float InY, float InRadius,
+	                               FVector2D& OutCenter, float& OutRadius);
+
 	void SetColliding(bool bColliding)
 	{
 		ShapeColor = bColliding ? FColor::Red : FColor::Green;
@@ -53,6 +78,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SAT Collision")
 	ESATCollisionResponse CollisionResponse = ESATCollisionResponse::Overlap;
 
+	// Slot in USATCollisionSubsystem's registry, INDEX_NONE while unregistered
+	int32 SATHandle = INDEX_NONE;
+
+	// Registration order, which spreads shapes evenly over the LOD scheduler's round robin
+	uint32 SATScheduleSlot = 0;
+
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSATOverlapEvent, AActor*, OtherActor);
 
 	UPROPERTY(BlueprintAssignable, Category = "SAT Collision")
@@ -79,4 +110,18 @@ protected:
 private:
 
 	void DrawDebugCircle2D() const;
+
+	void UpdateWorldCircle() const;
+
+	// Rebuilds the world circle if X, Y or Radius were written without a setter since the last build
+	void RefreshWorldCircle() const;
+
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	// Mutable so the getters can catch up with direct writes. Built* are the values it was built from.
+	mutable FVector2D WorldCenter = FVector2D::ZeroVector;
+	mutable float WorldRadius = 0.f;
+	mutable float BuiltX = 0.f;
+	mutable float BuiltY = 0.f;
+	mutable float BuiltRadius = 0.f;
 };
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SATCollisionTypes.h"
+#include "GameFramework/Actor.h"
+#include "OrientedBox2D.generated.h"
+
+UCLASS()
+class AOrientedBox2D : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AOrientedBox2D();
+
+protected:
+	virtual void BeginPlay() override;
+
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	virtual void Tick(float DeltaTime) override;
+
+	UPROPERTY()
+	USceneComponent* Root;
+
+	// Half size along the actor's local X and Y axes
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetHalfExtents, Category = "Box")
+	FVector2D HalfExtents = FVector2D(50.f, 50.f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Box Debug")
+	FColor ShapeColor = FColor::Green;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Box Debug")
+	float ZOffset = 10.f;
+
+	UFUNCTION(BlueprintSetter)
+	void SetHalfExtents(FVector2D InHalfExtents);
+
+	// World-space center, scaled half extents and local X axis, refreshed whenever the actor's
+	// transform or the box changes, including direct writes to HalfExtents
+	FVector2D GetWorldCenter() const { RefreshWorldBox(); return WorldCenter; }
+	FVector2D GetWorldHalfExtents() const { RefreshWorldBox(); return WorldHalfExtents; }
+	FVector2D GetWorldAxisX() const { RefreshWorldBox(); return WorldAxisX; }
+
+	// The world box of an actor at Transform, also used by the validation commandlet
+	static void ComputeWorldBox(const FTransform& Transform, const FVector2D& InHalfExtents,
+	                            FVector2D& OutCenter, FVector2D& OutHalfExtents, FVector2D& OutAxisX);
+
+	void SetColliding(bool bColliding)
+	{
+		ShapeColor = bColliding ? FColor::Red : FColor::Green;
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SAT Collision")
+	ESATCollisionResponse CollisionResponse = ESATCollisionResponse::Overlap;
+
+	// Slot in USATCollisionSubsystem's registry, INDEX_NONE while unregistered
+	int32 SATHandle = INDEX_NONE;
+
+	// Registration order, which spreads shapes evenly over the LOD scheduler's round robin
+	uint32 SATScheduleSlot = 0;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSATOverlapEvent, AActor*, OtherActor);
+
+	UPROPERTY(BlueprintAssignable, Category = "SAT Collision")
+	FSATOverlapEvent OnSATOverlapBeginDelegate;
+
+	UPROPERTY(BlueprintAssignable, Category = "SAT Collision")
+	FSATOverlapEvent OnSATOverlapEndDelegate;
+
+	UFUNCTION()
+	void HandleSATOverlapBegin(AActor* OtherActor);
+
+	UFUNCTION()
+	void HandleSATOverlapEnd(AActor* OtherActor);
+
+protected:
+	UFUNCTION(BlueprintNativeEvent, Category = "SAT Collision")
+	void OnSATOverlapBegin(AActor* OtherActor);
+	virtual void OnSATOverlapBegin_Implementation(AActor* OtherActor);
+
+	UFUNCTION(BlueprintNativeEvent, Category = "SAT Collision")
+	void OnSATOverlapEnd(AActor* OtherActor);
+	virtual void OnSATOverlapEnd_Implementation(AActor* OtherActor);
+
+private:
+	void DrawDebugOrientedBox2D() const;
+
+	void UpdateWorldBox() const;
+
+	// Rebuilds the world box if HalfExtents was written without a setter since the last build
+	void RefreshWorldBox() const;
+
+	void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	// Mutable so the getters can catch up with direct writes. BuiltHalfExtents is what it was built from.
+	mutable FVector2D WorldCenter = FVector2D::ZeroVector;
+	mutable FVector2D WorldHalfExtents = FVector2D::ZeroVector;
+	mutable FVector2D WorldAxisX = FVector2D(1.f, 0.f);
+	mutable FVector2D BuiltHalfExtents = FVector2D::ZeroVector;
+};
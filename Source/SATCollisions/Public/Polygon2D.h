@@ -7,6 +7,8 @@
 #include "GameFramework/Actor.h"
 #include "Polygon2D.generated.h"
 
+class USATHullAsset;
+
 UCLASS()
 class APolygon2D : public AActor
 {
@@ -29,6 +31,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Polygon")
 	TArray<FVector2D> Points;
 
+	// Shared outline used instead of Points, so identical props don't each carry their own copy
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Polygon")
+	TObjectPtr<USATHullAsset> Hull;
+
 	UFUNCTION(BlueprintCallable, Category = "Polygon")
 	void AddPoint(float X, float Y);
 
@@ -46,16 +52,19 @@ public:
 		ShapeColor = bColliding ? FColor::Red : FColor::Green;
 	}
 
-	TArray<FVector2D> GetLocalPoints() const
-	{
-		return Points;
-	}
+	TArray<FVector2D> GetLocalPoints() const;
 
 	TArray<FVector2D> GetTransformedPoints(const FTransform& Transform) const;
 	TArray<FVector2D> GetNormalsTransformed(const FTransform& Transform) const;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SAT Collision")
 	ESATCollisionResponse CollisionResponse = ESATCollisionResponse::Overlap;
+
+	// Slot in USATCollisionSubsystem's registry, INDEX_NONE while unregistered
+	int32 SATHandle = INDEX_NONE;
+
+	// Registration order, which spreads shapes evenly over the LOD scheduler's round robin
+	uint32 SATScheduleSlot = 0;
 	
 	void TranslatePoints(const FVector2D& Offset);
 	FVector2D GetCentroidWorld() const;
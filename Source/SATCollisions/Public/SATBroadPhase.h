@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SATCollisionSnapshot.h"
+#include "SATDynamicTree.h"
+
+/**
+ * Keeps a dynamic AABB tree in sync with the shapes of successive frames, matching proxies to
+ * shapes by FSATShapeState::Id. Shapes missing from a frame lose their proxy.
+ */
+class FSATBroadPhase
+{
+public:
+	explicit FSATBroadPhase(float Margin = 10.f)
+		: Tree(Margin)
+	{
+	}
+
+	// Inserts, moves or removes proxies for Shapes (whose world data must be up to date) and returns
+	// every pair of shape indices whose fat bounds overlap, sorted
+	void UpdatePairs(const FSATFrameState& Frame, const TArray<int32>& Shapes, TArray<TPair<int32, int32>>& OutPairs);
+
+	// Ids of the shapes whose fat bounds overlap Bounds as of the last update
+	void Query(const FBox2D& Bounds, TArray<uint32>& OutIds) const;
+
+	// Adds to Frame every contact from the last frame passed to StoreContacts whose shapes are both
+	// dormant in Frame, with its indices remapped. Call after UpdatePairs.
+	void AddLastContacts(FSATFrameState& Frame) const;
+
+	// Remembers Frame's contacts by shape id, replacing the previous frame's. A replay of a recording
+	// started mid-session seeds this with the first recorded frame, whose dormant pairs carry contacts
+	// from before the recording.
+	void StoreContacts(const FSATFrameState& Frame);
+
+	const FSATDynamicTree& GetTree() const { return Tree; }
+
+private:
+	struct FProxy
+	{
+		int32 ProxyId = INDEX_NONE;
+		uint32 LastUpdate = 0;
+	};
+
+	FSATDynamicTree Tree;
+	TMap<uint32, FProxy> Proxies;
+
+	// Index in the frame being updated, by proxy id
+	TArray<int32> ShapeIndexByProxy;
+
+	struct FLastContact
+	{
+		// Ids of the contact's ShapeA and ShapeB, its axis points from A to B
+		uint32 IdA = 0;
+		uint32 IdB = 0;
+		FSATContact Contact;
+	};
+
+	// By sorted shape ids
+	TMap<TPair<uint32, uint32>, FLastContact> LastContacts;
+
+	uint32 UpdateCount = 0;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SATCollisionTypes.h"
+#include "SATHull.h"
+#include "SATPrecision.h"
+
+enum class ESATShapeType : uint8
+{
+	Polygon,
+	Circle,
+	Capsule,
+	Box
+};
+
+constexpr int32 SATNumShapeTypes = 4;
+
+// State of a single shape as seen by the collision pipeline for one tick
+struct FSATShapeState
+{
+	uint32 Id = 0;
+	ESATShapeType Type = ESATShapeType::Polygon;
+	ESATCollisionResponse Response = ESATCollisionResponse::Overlap;
+	FTransform Transform;
+
+	// Set by the LOD scheduler on far shapes that are not due this tick. When detecting with a broad
+	// phase, pairs of two dormant shapes keep their result from the last tick instead of being tested.
+	bool bDormant = false;
+
+	// The actor's SATScheduleSlot, its place in the LOD round robin. Not serialized.
+	uint32 ScheduleSlot = 0;
+
+	// Polygon: local points. Capsule: the two world-space ends of its core segment.
+	TArray<FVector2D> Points;
+
+	// Polygon only: shared outline used instead of Points when set. Recorded as plain Points.
+	TSharedPtr<const FSATHull> Hull;
+
+	// Circle, capsule and box, already in world space (see ACircle2D::GetWorldCenter)
+	FVector2D Center = FVector2D::ZeroVector;
+	float Radius = 0.f;
+
+	// Box only: world half extents along AxisX and its perpendicular
+	FVector2D HalfExtents = FVector2D::ZeroVector;
+	FVector2D AxisX = FVector2D(1.f, 0.f);
+
+	// Derived from the fields above while the pipeline runs, never serialized. Positions are
+	// relative to Origin, in the pipeline's precision (see SATPrecision.h).
+	FVector2D Origin = FVector2D::ZeroVector;
+	TArray<FSATVector2> WorldPoints; // Polygon and box corners, capsule segment ends
+	TArray<FSATVector2> WorldNormals; // Outward, whatever winding the points were authored in
+	FSATVector2 WorldCenter = FSATVector2::ZeroVector;
+	FSATVector2 WorldAxes[2] = { FSATVector2(1, 0), FSATVector2(0, 1) }; // Box only
+	FSATVector2 WorldHalfExtents = FSATVector2::ZeroVector; // Box only
+	FBox2D WorldBounds = FBox2D(ForceInit); // Absolute, for the broad phase
+	FVector2D AppliedOffset = FVector2D::ZeroVector;
+
+	void UpdateWorldData();
+	void Translate(const FSATVector2& Delta);
+
+	// Moves the derived positions to be relative to NewOrigin, so two shapes can be compared. Each
+	// point is rounded once more, in the pipeline's precision.
+	void Rebase(const FVector2D& NewOrigin);
+
+	FVector2D ToWorld(const FSATVector2& Local) const { return Origin + FVector2D(Local); }
+
+	// False for shapes too degenerate to collide, e.g. a polygon with fewer than three points
+	bool HasArea() const;
+
+	friend FArchive& operator<<(FArchive& Ar, FSATShapeState& Shape);
+};
+
+struct FSATContactPoint
+{
+	FVector2D Position = FVector2D::ZeroVector;
+	float Depth = 0.f;
+};
+
+struct FSATContact
+{
+	// Indices into FSATFrameState::Shapes
+	int32 ShapeA = INDEX_NONE;
+	int32 ShapeB = INDEX_NONE;
+
+	// Unit normal pointing from ShapeA to ShapeB and the penetration along it. Both are zero when
+	// neither shape is Block, since such pairs are only tested for overlap.
+	FVector2D Axis = FVector2D::ZeroVector;
+	float Overlap = 0.f;
+
+	// Clipped contact manifold, only filled when FSATFrameState::bGenerateContactPoints is set
+	FSATContactPoint Points[2];
+	int32 NumPoints = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FSATContact& Contact);
+};
+
+struct FSATEventRecord
+{
+	uint32 IdA = 0;
+	uint32 IdB = 0;
+	bool bBegin = true;
+
+	friend FArchive& operator<<(FArchive& Ar, FSATEventRecord& Event);
+};
+
+struct FSATFrameState
+{
+	uint64 FrameNumber = 0;
+	float DeltaTime = 0.f;
+	bool bGenerateContactPoints = true;
+	TArray<FSATShapeState> Shapes;
+	TArray<FSATContact> Contacts;
+	TArray<FSATEventRecord> Events;
+
+	// Drops everything the pipeline produced so the frame can be run again
+	void ResetResults();
+
+	// Derives begin/end events from Contacts against the pairs that overlapped last frame
+	void BuildEvents(TSet<TPair<uint32, uint32>>& InOutOverlapIds);
+
+	friend FArchive& operator<<(FArchive& Ar, FSATFrameState& Frame);
+};
+
+// Writes one FSATFrameState per tick to a binary stream
+class FSATCollisionRecorder
+{
+public:
+	~FSATCollisionRecorder() { Close(); }
+
+	bool Open(const FString& Filename);
+	void Close();
+	bool IsRecording() const { return Writer.IsValid(); }
+
+	void WriteFrame(FSATFrameState& Frame);
+
+	const FString& GetFilename() const { return Filename; }
+
+private:
+	TUniquePtr<FArchive> Writer;
+	FString Filename;
+	int32 NumFrames = 0;
+};
+
+// Reads back a stream written by FSATCollisionRecorder
+class FSATCollisionReplayReader
+{
+public:
+	bool Open(const FString& Filename);
+	bool ReadFrame(FSATFrameState& OutFrame);
+
+private:
+	TUniquePtr<FArchive> Reader;
+};
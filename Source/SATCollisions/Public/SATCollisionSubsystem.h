@@ -4,12 +4,45 @@
 #include <vector>
 
 #include "CoreMinimal.h"
+#include "SATBroadPhase.h"
+#include "SATCollisionSnapshot.h"
+#include "SATDetectionBatch.h"
+#include "SATShapeRegistry.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "Tickable.h"
 #include "SATCollisionSubsystem.generated.h"
 
+DECLARE_STATS_GROUP(TEXT("SAT Collisions"), STATGROUP_SATCollision, STATCAT_Advanced);
+
 class APolygon2D;
 class ACircle2D;
+class ACapsule2D;
+class AOrientedBox2D;
+
+// Detection cost and output of one world, see SAT.WorldStats
+struct FSATWorldStats
+{
+	int32 NumShapes = 0;
+	int32 NumContacts = 0;
+
+	// Far shapes the LOD scheduler skipped this tick, see SAT.LODDistance
+	int32 NumDormantShapes = 0;
+
+	float DetectMs = 0.f;
+
+	// Smoothed over roughly the last 30 detections, contact points are shed while this is over budget
+	float AverageDetectMs = 0.f;
+
+	// Detection time per shape that was not dormant, which the LOD scheduler sizes each tick by
+	float MsPerTestedShape = 0.f;
+
+	// Detections that took longer than the budget on their own, whether or not the average was over it
+	int32 OverBudgetFrames = 0;
+
+	// Set while the average is over budget even with the far shapes capped, contact points are then
+	// skipped to cut its cost
+	bool bSheddingContactPoints = false;
+};
 
 UCLASS()
 class USATCollisionSubsystem : public UWorldSubsystem, public FTickableGameObject
@@ -17,11 +50,17 @@ class USATCollisionSubsystem : public UWorldSubsystem, public FTickableGameObjec
 	GENERATED_BODY()
 
 public:
+
+	virtual void Deinitialize() override;
 	
 	virtual void Tick(float DeltaTime) override;
 	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(USATCollisionSubsystem, STATGROUP_Tickables); }
-	virtual bool IsTickable() const override { return true; }
-	virtual bool IsTickableWhenPaused() const override { return true; }
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	// Worlds without shapes (including editor worlds, where nothing registers) and paused worlds
+	// drop out of the tick. A world with a frame in flight or overlaps left to end still ticks.
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override { return false; }
 	virtual bool IsTickableInEditor() const override { return true; }
 
 	// Automatically initialize
@@ -31,39 +70,175 @@ public:
 	void UnregisterPolygon(APolygon2D* Polygon);
 	void RegisterCircle(ACircle2D* Circle);
 	void UnregisterCircle(ACircle2D* Circle);
+	void RegisterCapsule(ACapsule2D* Capsule);
+	void UnregisterCapsule(ACapsule2D* Capsule);
+	void RegisterBox(AOrientedBox2D* Box);
+	void UnregisterBox(AOrientedBox2D* Box);
 
 	static void ProjectPolygonOntoAxis(const TArray<FVector2D>& Points, const FVector2D& Axis, float& OutMin, float& OutMax);
 
+	// Runs detection and Block resolution over a frame's shapes, filling Frame.Contacts.
+	// Only touches the frame and the broad phase, so recordings can be replayed without a world.
+	// Without a broad phase every pair of shapes is tested.
+	static void DetectCollisions(FSATFrameState& Frame, FSATBroadPhase* BroadPhase = nullptr);
+
+	// Shapes whose fat broad-phase bounds overlap Bounds as of the last detection pass
+	void QueryShapes(const FBox2D& Bounds, TArray<AActor*>& OutActors);
+
+	// Contact from this tick's narrow phase between two overlapping shapes, with Axis pointing from
+	// Actor to Other. Points are only filled while SAT.ContactPoints is enabled. Unless one of the
+	// shapes is Block, only the overlap itself is tested: Axis is zero, Overlap 0 and there are no points.
+	bool GetContact(const AActor* Actor, const AActor* Other, FSATContact& OutContact) const;
+
+	const FSATWorldStats& GetWorldStats() const { return WorldStats; }
+
+	// Logs how much outline data this world's polygons hold per shape and in shared hulls
+	void LogMemoryReport() const;
+
+	// Detection time this world may use each tick. Negative uses SAT.WorldBudgetMs. Near shapes are
+	// always tested, far ones only as many as fit, see ScheduleShapes.
+	void SetDetectionBudget(float InBudgetMs) { DetectionBudgetMs = InBudgetMs; }
+	float GetDetectionBudget() const;
+
+	bool StartRecording(const FString& Filename);
+	void StopRecording();
+	bool IsRecording() const { return Recorder.IsRecording(); }
+
 private:
-	TArray<TWeakObjectPtr<APolygon2D>> PolygonActors;
-	TArray<TWeakObjectPtr<ACircle2D>> CircleActors;
+	TSATShapeRegistry<APolygon2D> PolygonActors;
+	TSATShapeRegistry<ACircle2D> CircleActors;
+	TSATShapeRegistry<ACapsule2D> CapsuleActors;
+	TSATShapeRegistry<AOrientedBox2D> BoxActors;
+	TMap<uint32, TWeakObjectPtr<AActor>> ActorsById;
+
+	// Only touched by DetectCollisions, which may be running on the async task
+	FSATBroadPhase BroadPhase;
+
+	void GatherFrameState(FSATFrameState& Frame, TArray<AActor*>& OutActors);
+
+	// Marks the shapes beyond SAT.LODDistance of every player that are not due this tick as dormant.
+	// Due far shapes that don't fit in the detection budget are left for the next tick.
+	void ScheduleShapes(FSATFrameState& Frame, const TArray<AActor*>& FrameActors);
+
+	// Schedule slot of the far shape the round robin tests next
+	uint32 LODCursor = 0;
 
-	bool CheckSATCollision(const APolygon2D& A, const FTransform& TransformA,
-						   const APolygon2D& B, const FTransform& TransformB,
-						   FVector2D& OutAxis, float& OutOverlap);
+	// Resolution, events and debug colours for a detected frame. FrameActors lines up with
+	// Frame.Shapes and holds null for actors destroyed since the frame was gathered.
+	void ApplyFrameResults(FSATFrameState& Frame, const TArray<AActor*>& FrameActors);
 
-	FVector2D GetPolygonMTV(const APolygon2D& A, const FTransform& TransformA,
-										 const APolygon2D& B, const FTransform& TransformB);
+	static FSATContact& AddContact(FSATFrameState& Frame, int32 ShapeA, int32 ShapeB,
+	                               const FSATVector2& Axis, FSATReal Overlap);
 
-	void ApplyPolygonMTV(APolygon2D& A, const FTransform& TransformA,
-	                     APolygon2D& B, const FTransform& TransformB);
+	// Narrow phase and resolution for one candidate pair with a Block shape, specialised for every
+	// TypeA <= TypeB. The contact's Axis points from IndexA to IndexB.
+	template <ESATShapeType TypeA, ESATShapeType TypeB>
+	static void Collide(FSATFrameState& Frame, int32 IndexA, int32 IndexB);
 
+	// Overlap-only narrow phase for pairs where neither shape blocks. No axis, depth or contact
+	// points are tracked and it returns at the first separating axis.
+	template <ESATShapeType TypeA, ESATShapeType TypeB>
+	static bool TestOverlap(const FSATShapeState& A, const FSATShapeState& B);
 
-	bool CheckCircleCollision(const ACircle2D& A, const FTransform& TransformA,
-	                          const ACircle2D& B, const FTransform& TransformB,
-	                          FVector2D& OutAxis, float& OutOverlap);
+	// Runs Collide<TypeA, TypeB> or TestOverlap<TypeA, TypeB> over a run of pairs that all have those
+	// types, so the kernels are inlined into the loop and only the run itself is dispatched
+	template <ESATShapeType TypeA, ESATShapeType TypeB>
+	static void CollidePairs(FSATFrameState& Frame, TConstArrayView<TPair<int32, int32>> Pairs);
 
-	void ApplyCircleCircleMTV(ACircle2D& A, ACircle2D& B,
-								const FVector2D& Axis, float Overlap);
+	using FCollidePairsFunction = void (*)(FSATFrameState&, TConstArrayView<TPair<int32, int32>>);
 
-	bool CheckCirclePolygonCollision(const ACircle2D& Circle, const FTransform& TransformCircle,
-	                                 const APolygon2D& Polygon, const FTransform& TransformPolygon,
-	                                 FVector2D& OutAxis, float& OutOverlap);
+	// CollidePairs instantiations indexed by [TypeA][TypeB], null below the diagonal
+	static const FCollidePairsFunction CollidePairsTable[SATNumShapeTypes][SATNumShapeTypes];
 
-	void ApplyCirclePolygonMTV(ACircle2D& Circle, APolygon2D& Polygon,
-							   const FVector2D& Axis, float Overlap);
+	// Polygon-vs-polygon SAT with the reference face as contact normal, optionally clipping
+	// the incident edge against it for up to two contact points
+	static bool CheckSATCollision(const FSATShapeState& A, const FSATShapeState& B,
+	                              bool bGenerateContactPoints, FSATContact& OutContact);
+
+	// Box-vs-box SAT over the four face axes only, since opposite faces share an axis
+	static bool CheckBoxCollision(const FSATShapeState& A, const FSATShapeState& B,
+	                              bool bGenerateContactPoints, FSATContact& OutContact);
+
+	// Clips the incident segment against the side planes of the reference edge and adds the points
+	// below the reference face to OutContact, halfway between both surfaces
+	static void ClipContactPoints(const FSATShapeState& Reference, int32 ReferenceEdge,
+	                              const FSATVector2 IncidentSegment[2], FSATContact& OutContact);
+
+	// Edge of Incident facing the reference normal the most
+	static void FindIncidentSegment(const FSATShapeState& Incident, const FSATVector2& ReferenceNormal,
+	                                FSATVector2 OutSegment[2]);
+
+	// ProjectPolygonOntoAxis for the pipeline's origin-relative points
+	static void ProjectOntoAxis(const TArray<FSATVector2>& Points, const FSATVector2& Axis, FSATReal& OutMin, FSATReal& OutMax);
+
+	static FSATReal FindMaxSeparation(const FSATShapeState& A, const FSATShapeState& B, int32& OutEdge);
+
+	static int32 ClipSegmentToLine(FSATVector2 OutSegment[2], const FSATVector2 InSegment[2],
+	                               const FSATVector2& Normal, FSATReal Offset);
+
+	// Moves A back and B forward along Axis by half the overlap each
+	static void ApplySplitMTV(FSATShapeState& A, FSATShapeState& B,
+	                          const FSATVector2& Axis, FSATReal Overlap);
+
+
+	static bool CheckCircleCollision(const FSATVector2& CenterA, FSATReal RadiusA,
+	                                 const FSATVector2& CenterB, FSATReal RadiusB,
+	                                 FSATVector2& OutAxis, FSATReal& OutOverlap);
+
+	static void ApplyCircleCircleMTV(FSATShapeState& A, FSATShapeState& B,
+	                                 const FSATVector2& Axis, FSATReal Overlap);
+
+	// Closest-feature test: finds the polygon edge, or edge vertex, whose Voronoi region holds the
+	// circle center. OutAxis points from the polygon to the circle.
+	static bool CheckCirclePolygonCollision(const FSATShapeState& Circle, const FSATShapeState& Polygon,
+	                                        FSATVector2& OutAxis, FSATReal& OutOverlap);
+
+	// Closed form in the box's local frame: clamp the center to the extents. OutAxis points from
+	// the box to the circle.
+	static bool CheckCircleBoxCollision(const FSATShapeState& Circle, const FSATShapeState& Box,
+	                                    FSATVector2& OutAxis, FSATReal& OutOverlap);
+
+	// Capsule against a convex polygon or box: SAT over the polygon's face axes, the capsule's
+	// segment normal and the axis from each segment end to its closest polygon vertex, which
+	// covers the rounded caps. OutAxis points from the polygon to the capsule and OutEdge is the
+	// polygon edge when the axis is one of its faces, INDEX_NONE otherwise.
+	static bool CheckCapsulePolygonCollision(const FSATShapeState& Capsule, const FSATShapeState& Polygon,
+	                                         FSATVector2& OutAxis, FSATReal& OutOverlap, int32& OutEdge);
+
+	// Clips the capsule's side against the polygon face Edge when there is one, otherwise adds the
+	// deepest point of its cap. Axis points from the polygon to the capsule.
+	static void AddCapsulePolygonContactPoints(const FSATShapeState& Capsule, const FSATShapeState& Polygon,
+	                                           int32 Edge, const FSATVector2& Axis, FSATContact& OutContact);
+
+	// Closest points between both core segments, then a circle test between them
+	static bool CheckCapsuleCollision(const FSATShapeState& A, const FSATShapeState& B,
+	                                  FSATVector2& OutAxis, FSATReal& OutOverlap, FSATVector2& OutPointA);
+
+	// True if a face of A has all of B's points in front of it
+	static bool HasSeparatingFace(const FSATShapeState& A, const FSATShapeState& B);
+
+	static bool TestCirclePolygonOverlap(const FSATShapeState& Circle, const FSATShapeState& Polygon);
+	static bool TestCapsulePolygonOverlap(const FSATShapeState& Capsule, const FSATShapeState& Polygon);
 
 	TSet<TPair<AActor*, AActor*>> PreviousOverlaps;
+	TMap<TPair<const AActor*, const AActor*>, FSATContact> Contacts;
+
+	// SAT.AsyncDetection: frame gathered last tick, detected with every other world's in the shared
+	// FSATDetectionBatch until the next one
+	FSATDetectionJob PendingJob;
+	TArray<TWeakObjectPtr<AActor>> PendingActors;
+	double PendingGatherTime = 0.0;
+
+	// Waits for PendingJob if there is one, e.g. before reading the broad phase it updates
+	void WaitForPendingJob();
+
+	void UpdateWorldStats(const FSATFrameState& Frame, double DetectSeconds);
+
+	FSATWorldStats WorldStats;
+	float DetectionBudgetMs = -1.f;
+
+	FSATCollisionRecorder Recorder;
+	TSet<TPair<uint32, uint32>> RecordedOverlapIds;
 
 	static TPair<AActor*, AActor*> MakeSortedPair(AActor* A, AActor* B)
 	{
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "SATCollisionSnapshot.h"
+#include "Tasks/Task.h"
+
+class FSATBroadPhase;
+
+// One world's detection pass, owned by its USATCollisionSubsystem while it waits for the batch
+struct FSATDetectionJob
+{
+	FSATFrameState Frame;
+	FSATBroadPhase* BroadPhase = nullptr;
+
+	// Duration of the last run, also used to start the most expensive worlds first
+	double DetectSeconds = 0.0;
+
+	// Batch the job was launched with, invalid while it is still queued
+	UE::Tasks::FTask Task;
+	bool bQueued = false;
+
+	// Set once Frame has been detected and cleared by the owner after applying it, so a job that was
+	// waited for early (e.g. by a query) still has its results applied at the next sync point
+	std::atomic<bool> bResultsReady = false;
+};
+
+/**
+ * Collects the detection jobs every world's subsystem queues during a frame and launches them
+ * together at the end of the frame: one task that spreads the worlds over the worker pool, instead
+ * of one dispatch per world. Game thread only.
+ */
+class FSATDetectionBatch
+{
+public:
+	static FSATDetectionBatch& Get();
+
+	// Hooks the batch to the end of the frame and back off, called by FSATCollisionsModule
+	void Startup();
+	void Shutdown();
+
+	void Enqueue(FSATDetectionJob& Job);
+
+	// Blocks until Job has run. A job still waiting for the end of the frame runs inline instead.
+	void Wait(FSATDetectionJob& Job);
+
+	// Drops Job if it hasn't been launched yet, otherwise waits for it to finish
+	void Cancel(FSATDetectionJob& Job);
+
+	static bool IsPending(const FSATDetectionJob& Job) { return Job.bQueued || Job.Task.IsValid(); }
+
+	// Pending, or detected but not applied yet
+	static bool HasResultsToApply(const FSATDetectionJob& Job) { return IsPending(Job) || Job.bResultsReady; }
+
+private:
+	void Flush();
+
+	static void Run(FSATDetectionJob& Job);
+
+	TArray<FSATDetectionJob*> Queued;
+	FDelegateHandle EndFrameHandle;
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Incremental AABB tree (after Box2D's b2DynamicTree). Leaves hold fattened bounds so a shape
+ * that moves a little keeps its leaf; it is only re-inserted once it leaves its fat box.
+ * Insertion picks siblings with the surface area (perimeter) heuristic and AVL rotations keep
+ * the tree balanced.
+ */
+class FSATDynamicTree
+{
+public:
+	explicit FSATDynamicTree(float InMargin = 10.f)
+		: Margin(InMargin)
+	{
+	}
+
+	int32 CreateProxy(const FBox2D& Bounds, uint32 UserData);
+	void DestroyProxy(int32 ProxyId);
+
+	// Returns true if the proxy had to be re-inserted
+	bool MoveProxy(int32 ProxyId, const FBox2D& Bounds);
+
+	uint32 GetUserData(int32 ProxyId) const { return Nodes[ProxyId].UserData; }
+	const FBox2D& GetFatBounds(int32 ProxyId) const { return Nodes[ProxyId].Bounds; }
+
+	// Highest proxy id handed out so far plus one, for arrays indexed by proxy
+	int32 GetProxyCapacity() const { return Nodes.Num(); }
+
+	int32 GetHeight() const { return Root == INDEX_NONE ? 0 : Nodes[Root].Height; }
+
+	// Callback(ProxyId) for every leaf whose fat bounds overlap Bounds
+	template <typename FuncType>
+	void Query(const FBox2D& Bounds, FuncType&& Callback) const
+	{
+		if (Root == INDEX_NONE) return;
+
+		TArray<int32, TInlineAllocator<64>> Stack;
+		Stack.Add(Root);
+
+		while (Stack.Num() > 0)
+		{
+			const int32 NodeId = Stack.Pop(EAllowShrinking::No);
+			const FNode& Node = Nodes[NodeId];
+			if (!Overlaps(Node.Bounds, Bounds)) continue;
+
+			if (Node.IsLeaf())
+			{
+				Callback(NodeId);
+			}
+			else
+			{
+				Stack.Add(Node.Child1);
+				Stack.Add(Node.Child2);
+			}
+		}
+	}
+
+	// Callback(ProxyId, OtherProxyId) for every pair of overlapping leaves between this tree and Other
+	template <typename FuncType>
+	void QueryPairs(const FSATDynamicTree& Other, FuncType&& Callback) const
+	{
+		if (Root == INDEX_NONE || Other.Root == INDEX_NONE) return;
+
+		TArray<TPair<int32, int32>, TInlineAllocator<64>> Stack;
+		Stack.Emplace(Root, Other.Root);
+
+		while (Stack.Num() > 0)
+		{
+			const TPair<int32, int32> Pair = Stack.Pop(EAllowShrinking::No);
+			const FNode& A = Nodes[Pair.Key];
+			const FNode& B = Other.Nodes[Pair.Value];
+			if (!Overlaps(A.Bounds, B.Bounds)) continue;
+
+			DescendPair(Pair.Key, A, Pair.Value, B, Stack, Callback);
+		}
+	}
+
+	// Callback(ProxyA, ProxyB) once for every pair of overlapping leaves within this tree
+	template <typename FuncType>
+	void QueryAllPairs(FuncType&& Callback) const
+	{
+		if (Root == INDEX_NONE) return;
+
+		TArray<TPair<int32, int32>, TInlineAllocator<64>> Stack;
+		Stack.Emplace(Root, Root);
+
+		while (Stack.Num() > 0)
+		{
+			const TPair<int32, int32> Pair = Stack.Pop(EAllowShrinking::No);
+			const FNode& A = Nodes[Pair.Key];
+
+			// A subtree against itself: pairs are either within one child or across both
+			if (Pair.Key == Pair.Value)
+			{
+				if (!A.IsLeaf())
+				{
+					Stack.Emplace(A.Child1, A.Child1);
+					Stack.Emplace(A.Child2, A.Child2);
+					Stack.Emplace(A.Child1, A.Child2);
+				}
+				continue;
+			}
+
+			const FNode& B = Nodes[Pair.Value];
+			if (!Overlaps(A.Bounds, B.Bounds)) continue;
+
+			DescendPair(Pair.Key, A, Pair.Value, B, Stack, Callback);
+		}
+	}
+
+	static bool Overlaps(const FBox2D& A, const FBox2D& B)
+	{
+		return A.Min.X <= B.Max.X && B.Min.X <= A.Max.X
+			&& A.Min.Y <= B.Max.Y && B.Min.Y <= A.Max.Y;
+	}
+
+private:
+	struct FNode
+	{
+		FBox2D Bounds = FBox2D(ForceInit);
+
+		// Next free node while on the free list
+		int32 Parent = INDEX_NONE;
+
+		int32 Child1 = INDEX_NONE;
+		int32 Child2 = INDEX_NONE;
+
+		// 0 for leaves, -1 while free
+		int32 Height = 0;
+
+		uint32 UserData = 0;
+
+		bool IsLeaf() const { return Child1 == INDEX_NONE; }
+	};
+
+	template <typename StackType, typename FuncType>
+	static void DescendPair(int32 IndexA, const FNode& A, int32 IndexB, const FNode& B, StackType& Stack, FuncType& Callback)
+	{
+		if (A.IsLeaf() && B.IsLeaf())
+		{
+			Callback(IndexA, IndexB);
+		}
+		else if (B.IsLeaf() || (!A.IsLeaf() && A.Height >= B.Height))
+		{
+			Stack.Emplace(A.Child1, IndexB);
+			Stack.Emplace(A.Child2, IndexB);
+		}
+		else
+		{
+			Stack.Emplace(IndexA, B.Child1);
+			Stack.Emplace(IndexA, B.Child2);
+		}
+	}
+
+	int32 AllocateNode();
+	void FreeNode(int32 NodeId);
+
+	void InsertLeaf(int32 Leaf);
+	void RemoveLeaf(int32 Leaf);
+
+	// Walks up from Index restoring heights and bounds, rebalancing on the way
+	void RefitAncestors(int32 Index);
+
+	// Rotates the subtree at Index if it is imbalanced, returns the subtree's new root
+	int32 Balance(int32 Index);
+
+	TArray<FNode> Nodes;
+	int32 Root = INDEX_NONE;
+	int32 FreeList = INDEX_NONE;
+	float Margin;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Vertex stored as a 16-bit fraction of its hull's bounds
+struct FSATQuantizedPoint
+{
+	uint16 X = 0;
+	uint16 Y = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FSATQuantizedPoint& Point)
+	{
+		Ar << Point.X;
+		Ar << Point.Y;
+		return Ar;
+	}
+};
+
+/**
+ * Immutable convex outline shared by every polygon that uses the same USATHullAsset. Only the local
+ * bounds and the quantized vertices are persistent; the float vertices and the outward normals the
+ * pipeline works from are decoded once on load instead of being rebuilt for every shape every tick.
+ */
+struct FSATHull
+{
+	FBox2f Bounds = FBox2f(ForceInit);
+	TArray<FSATQuantizedPoint> QuantizedPoints;
+
+	// Decoded from the fields above
+	TArray<FVector2f> Points;
+	TArray<FVector2f> Normals; // Outward, whatever winding the points were authored in
+
+	static TSharedRef<FSATHull> Build(TConstArrayView<FVector2D> InPoints);
+
+	// Rebuilds Points and Normals from Bounds and QuantizedPoints
+	void Decode();
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return QuantizedPoints.GetAllocatedSize() + Points.GetAllocatedSize() + Normals.GetAllocatedSize();
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FSATHull& Hull);
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "SATHull.h"
+#include "SATHullAsset.generated.h"
+
+/**
+ * Convex outline that any number of APolygon2D can reference instead of carrying their own Points.
+ * Cooked builds only keep the quantized hull, the double-precision authoring points are editor only.
+ */
+UCLASS(BlueprintType)
+class USATHullAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+#if WITH_EDITORONLY_DATA
+	// Local-space outline, quantized to 16 bits per axis within its bounds when saved
+	UPROPERTY(EditAnywhere, Category = "Hull")
+	TArray<FVector2D> Points;
+#endif
+
+	// Null until the asset has points
+	const TSharedPtr<const FSATHull>& GetHull() const { return Hull; }
+
+	virtual void Serialize(FArchive& Ar) override;
+
+#if WITH_EDITOR
+	virtual void PostLoad() override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+private:
+	TSharedPtr<const FSATHull> Hull;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Precision of the collision pass. By default every kernel runs in float on shape data stored
+// relative to a nearby region origin (see FSATShapeState::Origin), so large worlds stay accurate
+// while the hot data is half the size of UE's double-precision vectors. Set SAT_DOUBLE_PRECISION
+// to 1 in SATCollisions.Build.cs to run the pass in double instead.
+#ifndef SAT_DOUBLE_PRECISION
+#define SAT_DOUBLE_PRECISION 0
+#endif
+
+#if SAT_DOUBLE_PRECISION
+using FSATReal = double;
+using FSATVector2 = FVector2d;
+#else
+using FSATReal = float;
+using FSATVector2 = FVector2f;
+#endif
+
+// Shapes are rebased onto the center of the region they are in. A power of two, so the offset
+// between two region origins is exact in float.
+constexpr double SATRegionSize = 8192.0;
+
+inline FVector2D GetSATRegionOrigin(const FVector2D& Position)
+{
+	return FVector2D(FMath::RoundToDouble(Position.X / SATRegionSize), FMath::RoundToDouble(Position.Y / SATRegionSize)) * SATRegionSize;
+}
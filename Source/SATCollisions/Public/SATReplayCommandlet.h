@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SATBroadPhase.h"
+#include "SATCollisionSnapshot.h"
+#include "SATReplayCommandlet.generated.h"
+
+// Detects recorded frames again, in order and without a world, and compares the results with the
+// recording. Used by -run=SATReplay and the SATCollisions.Replay automation tests.
+class FSATReplaySession
+{
+public:
+	// Replays Recorded into OutReplayed, running detection Repeat times, and returns the number of
+	// contacts/events that differ. OutSeconds is the average time of one run.
+	int32 ReplayFrame(const FSATFrameState& Recorded, FSATFrameState& OutReplayed, float Tolerance, int32 Repeat, double& OutSeconds);
+
+private:
+	FSATBroadPhase BroadPhase;
+	TSet<TPair<uint32, uint32>> OverlapIds;
+	bool bStarted = false;
+};
+
+/**
+ * Feeds a stream written by SAT.StartRecording back through USATCollisionSubsystem::DetectCollisions,
+ * reporting per-frame timings and any contact or event that no longer matches the recording.
+ *
+ * UnrealEditor-Cmd <Project> -run=SATReplay -File=<Recording> [-Repeat=<N>] [-Tolerance=<T>]
+ */
+UCLASS()
+class USATReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USATReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Slot array of registered shapes. Each shape keeps its slot index in SATHandle, so Add and Remove
+ * are O(1): removed slots are nulled and recycled through a free list, and Compact() closes the holes
+ * (and prunes actors destroyed without unregistering) between ticks. Each newly registered shape
+ * also gets the next SATScheduleSlot.
+ */
+template <typename ShapeType>
+class TSATShapeRegistry
+{
+public:
+	int32 Add(ShapeType* Shape)
+	{
+		if (Contains(Shape)) return Shape->SATHandle;
+
+		int32 Handle;
+		if (FreeList.Num() > 0)
+		{
+			Handle = FreeList.Pop(EAllowShrinking::No);
+			Slots[Handle] = Shape;
+		}
+		else
+		{
+			Handle = Slots.Add(Shape);
+		}
+
+		Shape->SATHandle = Handle;
+		Shape->SATScheduleSlot = NextScheduleSlot++;
+		return Handle;
+	}
+
+	void Remove(ShapeType* Shape)
+	{
+		if (!Contains(Shape)) return;
+
+		Slots[Shape->SATHandle].Reset();
+		FreeList.Add(Shape->SATHandle);
+		Shape->SATHandle = INDEX_NONE;
+	}
+
+	bool Contains(const ShapeType* Shape) const
+	{
+		return Shape && Slots.IsValidIndex(Shape->SATHandle) && Slots[Shape->SATHandle].Get() == Shape;
+	}
+
+	// Called while iterating when a slot turns out to hold an actor that was destroyed without unregistering
+	void MarkStale() { bHasStaleSlots = true; }
+
+	bool NeedsCompaction() const
+	{
+		return bHasStaleSlots || FreeList.Num() * 4 > Slots.Num();
+	}
+
+	// Moves live shapes down over empty slots, keeping their order. Returns how many of the empty
+	// slots held actors that were destroyed without unregistering.
+	int32 Compact()
+	{
+		int32 NumStale = 0;
+		int32 Write = 0;
+		for (int32 Read = 0; Read < Slots.Num(); ++Read)
+		{
+			ShapeType* Shape = Slots[Read].Get();
+			if (!Shape)
+			{
+				if (Slots[Read].IsStale()) ++NumStale;
+				continue;
+			}
+
+			if (Write != Read)
+			{
+				Slots[Write] = Slots[Read];
+				Shape->SATHandle = Write;
+			}
+			++Write;
+		}
+
+		Slots.SetNum(Write, EAllowShrinking::No);
+		FreeList.Reset();
+		bHasStaleSlots = false;
+		return NumStale;
+	}
+
+	// Number of slots, including empty ones waiting for compaction
+	int32 Num() const { return Slots.Num(); }
+
+	ShapeType* operator[](int32 Handle) const { return Slots[Handle].Get(); }
+
+	auto begin() const { return Slots.begin(); }
+	auto end() const { return Slots.end(); }
+
+private:
+	TArray<TWeakObjectPtr<ShapeType>> Slots;
+	TArray<int32> FreeList;
+	uint32 NextScheduleSlot = 0;
+	bool bHasStaleSlots = false;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SATValidateCommandlet.generated.h"
+
+/**
+ * Differential check of the narrow phase: runs random pairs of every shape type through
+ * USATCollisionSubsystem::DetectCollisions, both the full Block kernels and the overlap-only ones,
+ * and compares hit/miss, depth, axis and contact points against a brute-force double-precision SAT
+ * over polygon outlines of the same shapes. Shapes are authored like on their actors, as a rotated,
+ * scaled and sometimes mirrored transform plus the actor's properties, and go through the actors'
+ * cached world data math, while the reference transforms the properties directly. Shapes are also
+ * generated far from the world origin and across region boundaries (see SATPrecision.h), and half of
+ * the polygons use a shared FSATHull.
+ *
+ * It then moves crowds of shapes through an FSATBroadPhase for a few frames, some of them dormant,
+ * and checks its contacts against testing every pair, with dormant pairs keeping last frame's.
+ *
+ * UnrealEditor-Cmd <Project> -run=SATValidate [-Iterations=<N>] [-Seed=<S>] [-Tolerance=<T>]
+ *
+ * N pairs are tested per ordered type combination. Returns non-zero if any of them disagrees. The
+ * SATCollisions.NarrowPhase.Validation automation test runs the same check with fewer pairs.
+ */
+UCLASS()
+class USATValidateCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USATValidateCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	// Runs the check and returns the number of failures, logging the first few of each kind
+	static int32 RunValidation(int32 Iterations, int32 Seed, float Tolerance);
+};
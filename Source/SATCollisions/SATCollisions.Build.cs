@@ -7,6 +7,9 @@ public class SATCollisions : ModuleRules
 	public SATCollisions(ReadOnlyTargetRules Target) : base(Target)
 	{
 		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// 1 runs the collision pass in double instead of float, see SATPrecision.h
+		PublicDefinitions.Add("SAT_DOUBLE_PRECISION=0");
 		
 		PrivateIncludePaths.AddRange(
 			new string[] {